@@ -4,8 +4,10 @@ function(configure_llvm project_name)
         llvm_libs
         core
         support
+        bitreader
         bitwriter
         transformUtils
+        nativecodegen
     )
     target_include_directories(${project_name} SYSTEM PUBLIC ${LLVM_INCLUDE_DIRS})
     add_definitions(${LLVM_DEFINITIONS})
@@ -0,0 +1,59 @@
+//
+// Created by agent on 18/10/2026.
+//
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Dynamic arrays are { data, length, capacity } values owned by the
+ * generated code. Indexing and appending within capacity is inlined,
+ * runtime only manages the buffer.
+ */
+namespace {
+constexpr uint64_t MIN_CAPACITY = 4;
+
+[[noreturn]] void outOfMemory() {
+    std::fputs("Out of memory\n", stderr);
+    std::abort();
+}
+} // namespace
+
+extern "C" {
+
+struct LbcArrayBuffer {
+    void* data;
+    uint64_t capacity;
+};
+
+/**
+ * Grow the buffer to hold at least `required` elements of `size` bytes.
+ * Capacity at least doubles, so appending one by one is amortized
+ * constant time. First `length` elements are preserved, others are
+ * left uninitialized.
+ */
+LbcArrayBuffer __lbc_array_reserve(void* data, uint64_t length, uint64_t capacity, uint64_t required, uint64_t size) { // NOLINT
+    auto newCapacity = std::max({ required, capacity * 2, MIN_CAPACITY });
+    if (newCapacity > SIZE_MAX / std::max<uint64_t>(size, 1)) {
+        outOfMemory();
+    }
+
+    void* buffer = nullptr;
+    if (length == 0) {
+        std::free(data);
+        buffer = std::malloc(newCapacity * size);
+    } else {
+        buffer = std::realloc(data, newCapacity * size);
+    }
+    if (buffer == nullptr) {
+        outOfMemory();
+    }
+    return { buffer, newCapacity };
+}
+
+void __lbc_array_free(void* data) { // NOLINT
+    std::free(data);
+}
+
+} // extern "C"
@@ -21,6 +21,14 @@ fi
 #
 # ../lbc test-01.bas
 # ./test-01 | FileCheck test-01.bas
+#
+# header of a test can give extra compiler options:
+# '' FLAGS: <options>     used to build the executable
+# '' IR-FLAGS: <options>  emit llvm ir with <options> and match it
+#                         against the IR: lines
+#
+# test that should fail to compile gives expected diagnostic:
+# '' ERROR: <message>     compiler output is matched against ERROR: lines
 for file in `ls test-*.bas`
 do
     # the output file
@@ -29,9 +37,34 @@ do
     if [ -e $output ]; then
         rm $output
     fi
+    flags=`sed -n "s/^'' FLAGS: *//p" $file`
+    if grep -q "^'' ERROR:" $file; then
+        $ECHO "$red\c"
+        $LBC $flags $file -o $output 2>&1 | $FILECHECK $file --check-prefix=ERROR --dump-input=never
+        if [ $? = 0 ] && [ ! -e $output ]; then
+            $ECHO "$reset\c"
+            printf "%s%*s${green}Ok$reset\n" $file "$((25-${#file}))";
+        else
+            $ECHO "$reset\c"
+            printf "%s%*s${red}Failed$reset\n" $file "$((25-${#file}))";
+            rm -f $output
+        fi
+        continue
+    fi
+    irflags=`sed -n "s/^'' IR-FLAGS: *//p" $file`
+    if [ -n "$irflags" ]; then
+        $ECHO "$red\c"
+        $LBC $irflags -S -emit-llvm $file
+        $FILECHECK $file --check-prefix=IR --dump-input=never < $output.ll
+        if [ $? != 0 ]; then
+            printf "%s%*s${red}IR Failed$reset\n" $file "$((25-${#file}))";
+        fi
+        $ECHO "$reset\c"
+        rm -f $output.ll
+    fi
     # compile
     $ECHO "$red\c"
-    $LBC $file -o $output
+    $LBC $flags $file -o $output
     $ECHO "$reset\c"
     if [ -e $output ]; then
         $ECHO "$red\c"
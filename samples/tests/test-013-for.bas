@@ -7,6 +7,7 @@
 '' CHECK: 5, 4, 3, 2, 1
 '' CHECK: 6, 3, 0
 '' CHECK: 1, 4, 7
+'' CHECK: 7, 4, 1
 ''------------------------------------------------------------------------------
 import cstd
 
@@ -35,3 +36,8 @@ var e = 7
 var s = 3
 for i = b to e step s do printf "%i, ", i
 printf "\n"
+
+' direction known only at runtime
+s = -3
+for i = e to b step s do printf "%i, ", i
+printf "\n"
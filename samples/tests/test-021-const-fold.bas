@@ -0,0 +1,53 @@
+''------------------------------------------------------------------------------
+'' test-021-const-fold.bas
+'' - constant folding of binary expressions
+'' - integral wraparound and signedness
+'' - short circuiting logical operators
+''
+'' CHECK: 1048576, 7, -2, 2
+'' CHECK: 44, -56, 65535, 4294967295
+'' CHECK: 2.500000, 1.500000
+'' CHECK: true, false, true, true
+'' CHECK: called
+'' CHECK: true
+''------------------------------------------------------------------------------
+import cstd
+
+var mega = 1024 * 1024
+var seven = 3 + 4
+var neg = -8 / 4
+var rem = 17 mod 5
+printf "%d, %d, %d, %d\n", mega, seven, neg, rem
+
+var ub = (200 as ubyte) + (100 as ubyte)
+var sb = (100 as byte) + (100 as byte)
+var us = (0 as ushort) - (1 as ushort)
+var ui = (0 as uinteger) - (1 as uinteger)
+printf "%hhu, %hhi, %hu, %u\n", ub, sb, us, ui
+
+var half = 5 / 2.0
+var frem = 7.5 mod 3.0
+printf "%lf, %lf\n", half, frem
+
+out "",   (1 as uinteger) > (0 - 1 as integer)
+out ", ", (200 as ubyte) < (100 as ubyte)
+out ", ", 1 = 1 and 2 <> 3
+out ", ", false or 1.5 >= 1.5
+printf "\n"
+
+shortCircuit()
+
+sub shortCircuit
+    var b = false and called() or true and called()
+    out "", b
+    printf "\n"
+end sub
+
+function called() as bool
+    printf "called\n"
+    return true
+end function
+
+sub out(sep as zstring, b as bool)
+    printf "%s%s", sep, if b then "true" else "false"
+end sub
@@ -0,0 +1,25 @@
+''------------------------------------------------------------------------------
+'' test-022-const.bas
+'' - CONST declarations
+'' - constants folded into expressions
+''
+'' CHECK: 1048576, 255, 3.140000
+'' CHECK: Hello
+'' CHECK: 20
+''------------------------------------------------------------------------------
+import cstd
+
+const KB = 1024
+const MB = KB * KB
+const MAX_BYTE as ubyte = 255
+const PI as double = 3.14
+const GREETING = "Hello"
+
+printf "%d, %hhu, %lf\n", MB, MAX_BYTE, PI
+printf "%s\n", GREETING
+printf "%d\n", twice(10)
+
+function twice(value as integer) as integer
+    const factor = 2
+    return value * factor
+end function
@@ -0,0 +1,48 @@
+''------------------------------------------------------------------------------
+'' test-023-ctfe.bas
+'' - compile time function evaluation
+'' - impure functions are called at runtime
+''
+'' CHECK:      3628800
+'' CHECK-NEXT: 55
+'' CHECK-NEXT: 25
+'' CHECK-NEXT: impure 42
+''------------------------------------------------------------------------------
+import cstd
+
+function factorial(n as integer) as integer
+    if n <= 1 then return 1
+    return n * factorial(n - 1)
+end function
+
+function fib(n as integer) as integer
+    var a = 0
+    var b = 1
+    for i = 1 to n
+        var t = a + b
+        a = b
+        b = t
+    next
+    return a
+end function
+
+function sumOdd(limit as integer) as integer
+    var sum = 0
+    do var i = 0 while i < limit
+        i = i + 1
+        if i mod 2 = 0 then continue
+        sum = sum + i
+    loop
+    return sum
+end function
+
+function answer as integer
+    printf "impure "
+    return 42
+end function
+
+const FACT = factorial(10)
+printf "%d\n", FACT
+printf "%d\n", fib(10)
+printf "%d\n", sumOdd(10)
+printf "%d\n", answer()
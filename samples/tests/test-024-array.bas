@@ -0,0 +1,51 @@
+''------------------------------------------------------------------------------
+'' test-024-array.bas
+'' - fixed size arrays
+''
+'' CHECK:       sum = 14.000000
+'' CHECK-NEXT:  pts = 2, 10
+'' CHECK-NEXT:  m = 42, primes = 7
+'' CHECK-NEXT:  v = 1 2 3 0
+'' CHECK-NEXT:  *p = 2
+''------------------------------------------------------------------------------
+import cstd
+
+type Point
+    x as integer
+    y as integer
+end type
+
+type Shape
+    pts(0 to 2) as Point
+    count as integer
+end type
+
+const N = 8
+const primes(1 to 5) as integer = {2, 3, 5, 7, 11}
+
+var a(0 to N - 1) as double
+for i = 0 to N - 1
+    a(i) = i * 0.5
+next
+
+var sum = 0.0
+for i = 0 to N - 1
+    sum = sum + a(i)
+next
+printf "sum = %lf\n", sum
+
+var s as Shape
+for i = 0 to 2
+    s.pts(i).x = i
+    s.pts(i).y = i * 10
+next
+printf "pts = %d, %d\n", s.pts(2).x, s.pts(1).y
+
+var m(2, 1 to 3) as integer
+m(2, 3) = 42
+printf "m = %d, primes = %d\n", m(2, 3), primes(4)
+
+var v(0 to 3) as integer = {1, 2, 3}
+printf "v = %d %d %d %d\n", v(0), v(1), v(2), v(3)
+var p = @v(1)
+printf "*p = %d\n", *p
@@ -0,0 +1,51 @@
+''------------------------------------------------------------------------------
+'' test-025-dynamic-array.bas
+'' - dynamic arrays
+''
+'' CHECK:       empty = -1
+'' CHECK-NEXT:  len = 100, sum = 5050
+'' CHECK-NEXT:  a(9) = 10, ubound = 9
+'' CHECK-NEXT:  a(11) = 0
+'' CHECK-NEXT:  a = 0 0 0
+'' CHECK-NEXT:  tmp = 5 15
+'' CHECK-NEXT:  bounds = 1 TO 5
+''------------------------------------------------------------------------------
+import cstd
+
+function total(values() as integer) as long
+    var sum as long = 0
+    for i as long = 0 to ubound(values)
+        sum = sum + values(i)
+    next
+    return sum
+end function
+
+sub fill(n as integer)
+    var tmp() as integer
+    for i = 1 to n
+        append tmp, i
+    next
+    printf "tmp = %d %lld\n", tmp(n - 1), total(tmp)
+end sub
+
+var a() as integer
+printf "empty = %lld\n", ubound(a)
+
+for i = 1 to 100
+    append a, i
+next
+printf "len = %lld, sum = %lld\n", ubound(a) + 1, total(a)
+
+redim preserve a(9)
+printf "a(9) = %d, ubound = %lld\n", a(9), ubound(a)
+
+redim preserve a(11)
+printf "a(11) = %d\n", a(11)
+
+redim a(2)
+printf "a = %d %d %d\n", a(0), a(1), a(2)
+
+fill 5
+
+var st(1 to 5) as integer
+printf "bounds = %lld TO %lld\n", lbound(st), ubound(st)
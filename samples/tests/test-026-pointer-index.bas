@@ -0,0 +1,42 @@
+''------------------------------------------------------------------------------
+'' test-026-pointer-index.bas
+'' - pointer indexing and arithmetic
+''
+'' CHECK:       p[2] = 30, *(p + 3) = 40
+'' CHECK-NEXT:  sum = 150
+'' CHECK-NEXT:  a = 1 20 3 4 5
+'' CHECK-NEXT:  distance = 4, back = 20
+'' CHECK-NEXT:  h.p[1] = 9
+''------------------------------------------------------------------------------
+import cstd
+
+type Holder
+    p as integer ptr
+end type
+
+function sum(p as integer ptr, n as integer) as integer
+    var total = 0
+    for i = 0 to n - 1
+        total = total + p[i]
+    next
+    return total
+end function
+
+var a(5) as integer = { 10, 20, 30, 40, 50 }
+var p = @a(0)
+printf "p[2] = %d, *(p + 3) = %d\n", p[2], *(p + 3)
+printf "sum = %d\n", sum(p, 5)
+
+for i = 0 to 4
+    if i <> 1 then p[i] = i + 1
+next
+printf "a = %d %d %d %d %d\n", a(0), a(1), a(2), a(3), a(4)
+
+var last = 4 + p
+var q = last - 1
+printf "distance = %lld, back = %d\n", last - p, q[-2]
+
+var h as Holder
+h.p = p + 2
+h.p[1] = 9
+printf "h.p[1] = %d\n", a(3)
@@ -0,0 +1,82 @@
+''------------------------------------------------------------------------------
+'' test-027-func-effects.bas
+'' - functions keep their side effects with inferred attributes
+''
+'' IR-FLAGS: -O0
+''
+'' IR-DAG:      define internal i32 @SQUARE(i32 %X) [[PURE:#[0-9]+]]
+'' IR-DAG:      define internal i32 @SCALED(i32 %X) [[READS:#[0-9]+]]
+'' IR-DAG:      define internal void @DOUBLEALL(i32* %P, i32 %N) [[ARGMEM:#[0-9]+]]
+'' IR-DAG:      define internal i32 @WARM(i32* %P) [[ARGREAD:#[0-9]+]]
+'' IR-DAG:      define internal i32 @FIB(i32 %N) [[RECURSIVE:#[0-9]+]]
+'' IR-DAG:      attributes [[PURE]] = { nounwind readnone willreturn }
+'' IR-DAG:      attributes [[READS]] = { nounwind readonly willreturn }
+'' IR-DAG:      attributes [[ARGMEM]] = { argmemonly nounwind }
+'' IR-DAG:      attributes [[ARGREAD]] = { argmemonly nounwind readonly willreturn }
+'' IR-DAG:      attributes [[RECURSIVE]] = { nounwind readnone }
+''
+'' CHECK:       squares = 285
+'' CHECK-NEXT:  scaled = 10 30
+'' CHECK-NEXT:  a = 2 4 6
+'' CHECK-NEXT:  warm = 2
+'' CHECK-NEXT:  fib = 55
+'' CHECK-NEXT:  counter = 3
+''------------------------------------------------------------------------------
+import cstd
+
+var factor = 10
+var counter = 0
+
+function square(x as integer) as integer
+    return x * x
+end function
+
+function scaled(x as integer) as integer
+    return x * factor
+end function
+
+sub doubleAll(p as integer ptr, n as integer)
+    for i = 0 to n - 1
+        p[i] = p[i] * 2
+    next
+end sub
+
+sub doubleFirst(p as integer ptr, n as integer)
+    doubleAll p, n
+end sub
+
+function warm(p as integer ptr) as integer
+    prefetch(p)
+    return p[0]
+end function
+
+function fib(n as integer) as integer
+    if n < 2 then return n
+    return fib(n - 1) + fib(n - 2)
+end function
+
+sub tick
+    counter = counter + 1
+end sub
+
+var sum = 0
+for i = 0 to 9
+    sum = sum + square(i)
+next
+printf "squares = %d\n", sum
+
+var first = scaled(1)
+factor = 30
+printf "scaled = %d %d\n", first, scaled(1)
+
+var a(3) as integer = { 1, 2, 3 }
+doubleFirst(@a(0), 3)
+printf "a = %d %d %d\n", a(0), a(1), a(2)
+printf "warm = %d\n", warm(@a(0))
+
+printf "fib = %d\n", fib(10)
+
+tick()
+tick()
+tick()
+printf "counter = %d\n", counter
@@ -0,0 +1,50 @@
+''------------------------------------------------------------------------------
+'' test-028-func-attributes.bas
+'' - inlining and layout attributes
+''
+'' IR-FLAGS: -O0
+''
+'' IR:          define internal i32 @TWICE(i32 %X) [[INLINE:#[0-9]+]]
+'' IR:          define internal i32 @ADD(i32 %A, i32 %B) [[NOINLINE:#[0-9]+]]
+'' IR:          define internal i32 @TOTAL(i32 %N) [[HOT:#[0-9]+]]
+'' IR:          call i32 @TWICE(i32 %I.0) [[CALLINLINE:#[0-9]+]]
+'' IR-NEXT:     call i32 @ADD(i32 %SUM.0, i32 %{{[0-9]+}}){{$}}
+'' IR:          define internal void @REPORT(i32 %CODE) [[COLD:#[0-9]+]]
+'' IR-DAG:      attributes [[INLINE]] = { alwaysinline {{.*}}}
+'' IR-DAG:      attributes [[NOINLINE]] = { noinline {{.*}}}
+'' IR-DAG:      attributes [[HOT]] = { hot {{.*}}}
+'' IR-DAG:      attributes [[COLD]] = { cold {{.*}}}
+'' IR-DAG:      attributes [[CALLINLINE]] = { alwaysinline }
+''
+'' CHECK:       sum = 2550
+'' CHECK-NEXT:  error 42
+''------------------------------------------------------------------------------
+import cstd
+
+[Inline] _
+function twice(x as integer) as integer
+    return x * 2
+end function
+
+[NoInline] _
+function add(a as integer, b as integer) as integer
+    return a + b
+end function
+
+[Hot, Flatten] _
+function total(n as integer) as integer
+    var sum = 0
+    for i = 1 to n
+        sum = add(sum, twice(i))
+    next
+    return sum
+end function
+
+[Cold] _
+sub report(code as integer)
+    printf "error %d\n", code
+end sub
+
+printf "sum = %d\n", total(50)
+if total(1) <> 2 then report(1)
+report(42)
@@ -0,0 +1,68 @@
+''------------------------------------------------------------------------------
+'' test-029-align.bas
+'' - [Align(n)] on TYPE declarations and members
+''
+'' CHECK:       Vec size = 16
+'' CHECK-NEXT:  Header size = 48, count at 8, v at 16, last at 32
+'' CHECK-NEXT:  Wire size = 12, value at 4, flag at 8
+'' CHECK-NEXT:  h.count = 3, h.v.y = 2.5, h.last = 7
+'' CHECK-NEXT:  w.value = 1234, w.flag = 1
+''------------------------------------------------------------------------------
+import cstd
+
+[Align(16)] type Vec
+    x as single
+    y as single
+    z as single
+end type
+
+type Header
+    tag as byte
+    [Align(8)] count as integer
+    v as Vec
+    last as byte
+end type
+
+[Packed, Align(4)] type Wire
+    tag as byte
+    [Align(4)] value as integer
+    flag as byte
+end type
+
+function distance(first as any ptr, second as any ptr) as long
+    return (second as byte ptr) - (first as byte ptr)
+end function
+
+var vs(2) as Vec
+printf "Vec size = %lld\n", distance(@vs(0), @vs(1))
+
+var hs(2) as Header
+printf "Header size = %lld, count at %lld, v at %lld, last at %lld\n", _
+    distance(@hs(0), @hs(1)), _
+    distance(@hs(0), @hs(0).count), _
+    distance(@hs(0), @hs(0).v), _
+    distance(@hs(0), @hs(0).last)
+
+var ws(2) as Wire
+printf "Wire size = %lld, value at %lld, flag at %lld\n", _
+    distance(@ws(0), @ws(1)), _
+    distance(@ws(0), @ws(0).value), _
+    distance(@ws(0), @ws(0).flag)
+
+[Align(64)] var h as Header
+h.count = 3
+h.v.y = 2.5
+h.last = 7
+printf "h.count = %d, h.v.y = %g, h.last = %d\n", h.count, (h.v.y) as double, h.last
+
+var w as Wire
+sub fill()
+    [Align(32)] var t as Wire
+    t.value = 1234
+    t.flag = 1
+    w.value = t.value
+    w.flag = t.flag
+end sub
+
+fill()
+printf "w.value = %d, w.flag = %d\n", w.value, w.flag
@@ -0,0 +1,40 @@
+''------------------------------------------------------------------------------
+'' test-030-reorder.bas
+'' - [Reorder] lays out TYPE members by alignment
+''
+'' CHECK:       Loose size = 24
+'' CHECK-NEXT:  Tight size = 16
+'' CHECK-NEXT:  a = 1, b = 2, c = 3, d = 4
+''------------------------------------------------------------------------------
+import cstd
+
+type Loose
+    a as byte
+    b as long
+    c as byte
+    d as integer
+end type
+
+[Reorder] type Tight
+    a as byte
+    b as long
+    c as byte
+    d as integer
+end type
+
+function distance(first as any ptr, second as any ptr) as long
+    return (second as byte ptr) - (first as byte ptr)
+end function
+
+var ls(2) as Loose
+printf "Loose size = %lld\n", distance(@ls(0), @ls(1))
+
+var ts(2) as Tight
+printf "Tight size = %lld\n", distance(@ts(0), @ts(1))
+
+var t as Tight
+t.a = 1
+t.b = 2
+t.c = 3
+t.d = 4
+printf "a = %d, b = %lld, c = %d, d = %d\n", t.a, t.b, t.c, t.d
@@ -0,0 +1,58 @@
+''------------------------------------------------------------------------------
+'' test-031-vector.bas
+'' - VECTOR types apply operators to every lane
+''
+'' CHECK:       a = 1 2 3 4
+'' CHECK-NEXT:  sum = 3.5 4.5 5.5 6.5
+'' CHECK-NEXT:  prod = 2 6 12 20
+'' CHECK-NEXT:  max = 2.5 2.5 3 4
+'' CHECK-NEXT:  rev = 4 3 2 1
+'' CHECK-NEXT:  mix = 1 2.5 3 2.5
+'' CHECK-NEXT:  d = 0.25 -1.5
+'' CHECK-NEXT:  i = 0 3 6 9 12 15 18 21
+'' CHECK-NEXT:  neg = 0 -1
+''------------------------------------------------------------------------------
+import cstd
+
+sub vectors()
+    var a as single vector(4)
+    a[0] = 1
+    a[1] = 2
+    a[2] = 3
+    a[3] = 4
+    printf "a = %g %g %g %g\n", (a[0]) as double, (a[1]) as double, (a[2]) as double, (a[3]) as double
+
+    var b as single vector(4) = 2.5
+    var sum = a + b
+    printf "sum = %g %g %g %g\n", (sum[0]) as double, (sum[1]) as double, (sum[2]) as double, (sum[3]) as double
+
+    var prod = a * (a + 1)
+    printf "prod = %g %g %g %g\n", (prod[0]) as double, (prod[1]) as double, (prod[2]) as double, (prod[3]) as double
+
+    var m = if a > b then a else b
+    printf "max = %g %g %g %g\n", (m[0]) as double, (m[1]) as double, (m[2]) as double, (m[3]) as double
+
+    var rev = shuffle(a, {3, 2, 1, 0})
+    printf "rev = %g %g %g %g\n", (rev[0]) as double, (rev[1]) as double, (rev[2]) as double, (rev[3]) as double
+
+    var mix = shuffle(a, b, {0, 5, 2, 7})
+    printf "mix = %g %g %g %g\n", (mix[0]) as double, (mix[1]) as double, (mix[2]) as double, (mix[3]) as double
+
+    var d as double vector(2)
+    d[0] = 0.5
+    d[1] = -3.0
+    d = d / 2
+    printf "d = %g %g\n", d[0], d[1]
+
+    var i as integer vector(8)
+    for lane as integer = 0 to 7
+        i[lane] = lane
+    next
+    i = i * 3
+    printf "i = %d %d %d %d %d %d %d %d\n", i[0], i[1], i[2], i[3], i[4], i[5], i[6], i[7]
+
+    var n = -shuffle(i, {0, 1}) / 3
+    printf "neg = %d %d\n", n[0], n[1]
+end sub
+
+vectors()
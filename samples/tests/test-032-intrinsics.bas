@@ -0,0 +1,59 @@
+''------------------------------------------------------------------------------
+'' test-032-intrinsics.bas
+'' - built-in math and bit functions
+''
+'' CHECK:       sqr = 1.5 3
+'' CHECK-NEXT:  abs = 2.5 7 7
+'' CHECK-NEXT:  min = -3 2.5 max = 4 8
+'' CHECK-NEXT:  fma = 7
+'' CHECK-NEXT:  floor = -3 ceil = 3
+'' CHECK-NEXT:  popcount = 8 clz = 20 ctz = 4
+'' CHECK-NEXT:  bswap = 78563412
+'' CHECK-NEXT:  vmax = 3 3 5 7
+'' CHECK-NEXT:  sum = 12
+''------------------------------------------------------------------------------
+import cstd
+
+sub intrinsics()
+    var x = 2.25
+    printf "sqr = %g %g\n", sqr(x), sqr(9)
+
+    var i = -7
+    var l as long = -7
+    printf "abs = %g %d %lld\n", abs(-x - 0.25), abs(i), abs(l)
+
+    printf "min = %d %g max = %d %d\n", min(i + 4, 5), min(x + 0.25, 3), max(4, 2), max(i, 8)
+
+    printf "fma = %g\n", fma(x, 2.0, 2.5)
+
+    var f = -2.5
+    printf "floor = %g ceil = %g\n", floor(f), ceil(-f)
+
+    var bits as uinteger = 4080
+    printf "popcount = %d clz = %d ctz = %d\n", popcount(bits), clz(bits), ctz(bits)
+
+    var word as uinteger = 305419896
+    printf "bswap = %x\n", bswap(word)
+
+    var a as integer vector(4)
+    var b as integer vector(4)
+    for lane as integer = 0 to 3
+        a[lane] = lane * 2 + 1
+        b[lane] = 5
+    next
+    var m = max(a, b - (if a < 5 then 2 else 5))
+    printf "vmax = %d %d %d %d\n", m[0], m[1], m[2], m[3]
+
+    var data(8) as integer
+    var sum = 0
+    for index as integer = 0 to 7
+        data(index) = index / 2
+    next
+    for index as integer = 0 to 7
+        prefetch(@data(index))
+        sum = sum + data(index)
+    next
+    printf "sum = %d\n", sum
+end sub
+
+intrinsics()
@@ -0,0 +1,52 @@
+''------------------------------------------------------------------------------
+'' test-033-bitwise.bas
+'' - AND, OR, XOR and NOT are bitwise on integers, SHL and SHR shift them
+''
+'' CHECK:       and = 8 or = 14 xor = 6 not = -13
+'' CHECK-NEXT:  shl = 48 shr = 3 sar = -4 lshr = 2147483644
+'' CHECK-NEXT:  const = 4 255 -2 1024
+'' CHECK-NEXT:  pack = 66051 unpack = 1 2 3
+'' CHECK-NEXT:  logic = true false
+'' CHECK-NEXT:  hash = 1883757534
+'' CHECK-NEXT:  mask = 256 2 256
+''------------------------------------------------------------------------------
+import cstd
+
+function sh(value as integer, amount as integer) as integer
+    return value shl amount
+end function
+
+sub bitwise()
+    var a = 12
+    var b = 10
+    printf "and = %d or = %d xor = %d not = %d\n", a and b, a or b, a xor b, not a
+
+    var n = -7
+    var u as uinteger = -7
+    printf "shl = %d shr = %d sar = %d lshr = %u\n", a shl 2, a shr 2, n shr 1, u shr 1
+
+    const mask = 1 shl 3 shr 1
+    printf "const = %d %d %d %d\n", mask, 4095 and 255, not 1, 1 shl 2 + 8
+
+    var r as ubyte = 1
+    var g as ubyte = 2
+    var bl as ubyte = 3
+    var packed = (r as uinteger) shl 16 or (g as uinteger) shl 8 or bl
+    printf "pack = %d unpack = %d %d %d\n", packed, packed shr 16, (packed shr 8) and 255, packed and 255
+
+    var t = true
+    var f = false
+    printf "logic = %s %s\n", if t xor f then "true" else "false", if t xor t then "true" else "false"
+
+    var hash as uinteger = 0
+    for index as integer = 1 to 50
+        hash = (hash shl 5) xor (hash shr 2) xor index
+    next
+    printf "hash = %u\n", hash
+
+    ' shift amount is masked to the width of the type
+    var amount = 40
+    printf "mask = %d %d %d\n", 1 shl amount, sh(1, 33), 1 shl 40
+end sub
+
+bitwise()
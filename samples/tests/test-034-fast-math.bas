@@ -0,0 +1,71 @@
+''------------------------------------------------------------------------------
+'' test-034-fast-math.bas
+'' - [FastMath] relaxes floating point semantics of a single function
+''
+'' IR-FLAGS: -O0
+''
+'' IR:          define internal double @DOT(double* %A, double* %B, i32 %N) [[FAST:#[0-9]+]]
+'' IR:          fmul fast double
+'' IR-NEXT:     fadd fast double
+'' IR:          define internal double @HALF(double %X) [[FASTPURE:#[0-9]+]]
+'' IR:          fdiv fast double
+'' IR:          define internal i1 @ISNAN(double %X) [[STRICT:#[0-9]+]]
+'' IR:          = fcmp une double
+'' IR:          define internal void @KERNELS()
+'' IR:          = fdiv double
+'' IR-DAG:      attributes [[FAST]] = { {{.*}} "approx-func-fp-math"="true" "no-infs-fp-math"="true" "no-nans-fp-math"="true" "no-signed-zeros-fp-math"="true" "unsafe-fp-math"="true" }
+'' IR-DAG:      attributes [[FASTPURE]] = { {{.*}} "unsafe-fp-math"="true" }
+'' IR-DAG:      attributes [[STRICT]] = { nounwind readnone willreturn }
+''
+'' CHECK:       dot = 1360
+'' CHECK-NEXT:  sum = 136
+'' CHECK-NEXT:  half = 68
+'' CHECK-NEXT:  nan = 1
+''------------------------------------------------------------------------------
+import cstd
+
+[FastMath] _
+function dot(a as double ptr, b as double ptr, n as integer) as double
+    var sum = 0.0
+    for i as integer = 0 to n - 1
+        sum = sum + a[i] * b[i]
+    next
+    return sum
+end function
+
+[FastMath] _
+function total(a as single ptr, n as integer) as single
+    var sum as single = 0
+    for i as integer = 0 to n - 1
+        sum = sum + a[i]
+    next
+    return sum
+end function
+
+[FastMath] _
+function half(x as double) as double
+    return x / 2
+end function
+
+function isNan(x as double) as bool
+    return x <> x
+end function
+
+sub kernels()
+    var a(16) as double
+    var b(16) as double
+    var s(16) as single
+    for i as integer = 0 to 15
+        a(i) = i + 1
+        b(i) = 10
+        s(i) = i + 1
+    next
+    printf "dot = %g\n", dot(@a(0), @b(0), 16)
+    printf "sum = %g\n", (total(@s(0), 16)) as double
+    printf "half = %g\n", half(136.0)
+
+    var zero = 0.0
+    printf "nan = %d\n", if isNan(zero / zero) then 1 else 0
+end sub
+
+kernels()
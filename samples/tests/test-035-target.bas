@@ -0,0 +1,23 @@
+''------------------------------------------------------------------------------
+'' test-035-target.bas
+'' - -march and -mattr select the CPU functions are generated for
+''
+'' FLAGS: -march=x86-64 -mattr=+sse4.2
+'' IR-FLAGS: -march=x86-64 -mattr=+avx2,-fma
+''
+'' CHECK:       sum = 120
+''
+'' IR:          define {{.*}} @main() {{.*}}#[[ATTRS:[0-9]+]]
+'' IR:          attributes #[[ATTRS]] = { {{.*}}"target-cpu"="x86-64" "target-features"="+avx2,-fma" }
+''------------------------------------------------------------------------------
+import cstd
+
+sub target()
+    var sum = 0
+    for i as integer = 1 to 15
+        sum = sum + i
+    next
+    printf "sum = %d\n", sum
+end sub
+
+target()
@@ -0,0 +1,31 @@
+''------------------------------------------------------------------------------
+'' test-036-wrapv.bas
+'' - with -fwrapv signed overflow wraps around, whether the expression
+''   is folded, evaluated at compile time or computed at runtime
+''
+'' FLAGS: -fwrapv
+''
+'' CHECK:       const = -2147483648 2147483645
+'' CHECK-NEXT:  ctfe = -2147483648
+'' CHECK-NEXT:  runtime = -2147483648 2
+''------------------------------------------------------------------------------
+import cstd
+
+const big as integer = 2147483647
+const wrapped = big + 1
+const product = big * 3
+
+function increment(value as integer) as integer
+    return value + 1
+end function
+
+sub overflow()
+    printf "const = %d %d\n", wrapped, product
+    printf "ctfe = %d\n", increment(big)
+
+    var value = big
+    var factor = 2
+    printf "runtime = %d %d\n", value + 1, value * factor * factor + 6
+end sub
+
+overflow()
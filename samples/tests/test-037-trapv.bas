@@ -0,0 +1,37 @@
+''------------------------------------------------------------------------------
+'' test-037-trapv.bas
+'' - with -ftrapv signed overflow aborts the program. Expressions that
+''   would overflow are not folded at compile time, so they trap too
+''
+'' FLAGS: -ftrapv
+'' IR-FLAGS: -ftrapv -O0
+''
+'' CHECK:       sum = 2147483647
+'' CHECK-NEXT:  ctfe = 2147483647
+''
+'' IR-LABEL:    define {{.*}} @OVERFLOW()
+'' IR:          call { i32, i1 } @llvm.sadd.with.overflow.i32(i32 2147483647, i32 1)
+'' IR:          call void @llvm.trap()
+'' IR:          call { i32, i1 } @llvm.smul.with.overflow.i32(i32 2147483647, i32 2)
+''------------------------------------------------------------------------------
+import cstd
+
+const big as integer = 2147483647
+
+function increment(value as integer) as integer
+    return value + 1
+end function
+
+sub overflow()
+    printf "overflow = %d %d\n", big + 1, big * 2
+end sub
+
+sub fits()
+    printf "sum = %d\n", big - 1 + 1
+    printf "ctfe = %d\n", increment(big - 1)
+    if rand() < 0 then
+        overflow()
+    end if
+end sub
+
+fits()
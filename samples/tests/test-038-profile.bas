@@ -0,0 +1,21 @@
+''------------------------------------------------------------------------------
+'' test-038-profile.bas
+'' - -fprofile-generate instruments functions with counters and
+''   embeds the path where the runtime writes the profile
+''
+'' IR-FLAGS: -fprofile-generate=prof
+''
+'' IR:          @__profc_main = {{.*}} section "__llvm_prf_cnts"
+'' IR:          @__llvm_profile_filename = {{.*}} c"prof/default_%m.profraw\00"
+'' IR-LABEL:    define {{.*}} @main(
+'' IR:          load i64, {{.*}} @__profc_main
+''
+'' CHECK:       twice = 42
+''------------------------------------------------------------------------------
+import cstd
+
+function twice(value as integer) as integer
+    return value * 2
+end function
+
+printf "twice = %d\n", twice(21)
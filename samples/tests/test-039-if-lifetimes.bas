@@ -0,0 +1,48 @@
+''------------------------------------------------------------------------------
+'' test-039-if-lifetimes.bas
+'' - stack slots declared in if headers end on every path that started
+''   them, never in the merge block
+''
+'' IR-FLAGS: -O0
+''
+'' IR-LABEL:    define {{.*}} @TEST(
+'' IR:          call void @llvm.lifetime.start{{.*}}(i64 4, i8* %{{[0-9]+}})
+'' IR-LABEL:    if.then:
+'' IR:          bitcast i32* %A to i8*
+'' IR-NEXT:     call void @llvm.lifetime.end
+'' IR-NEXT:     br label %if.end
+'' IR-LABEL:    if.then1:
+'' IR:          bitcast i32* %B to i8*
+'' IR-NEXT:     call void @llvm.lifetime.end
+'' IR-NEXT:     bitcast i32* %A to i8*
+'' IR-NEXT:     call void @llvm.lifetime.end
+'' IR-NEXT:     br label %if.end
+'' IR-LABEL:    if.else2:
+'' IR:          bitcast i32* %B to i8*
+'' IR-NEXT:     call void @llvm.lifetime.end
+'' IR-NEXT:     bitcast i32* %A to i8*
+'' IR-NEXT:     call void @llvm.lifetime.end
+'' IR-NEXT:     br label %if.end
+'' IR-LABEL:    if.end:
+'' IR-NEXT:     ret void
+''
+'' CHECK:       zero one
+''------------------------------------------------------------------------------
+import cstd
+
+function peek(p as integer ptr) as integer
+    return *p
+end function
+
+sub test(n as integer)
+    if var a = n, peek(@a) = 0 then
+        printf "zero "
+    else if var b = n * 2, peek(@b) = 2 then
+        printf "one "
+    end if
+end sub
+
+test(0)
+test(1)
+test(2)
+printf "\n"
@@ -0,0 +1,66 @@
+''------------------------------------------------------------------------------
+'' test-040-for-counted.bas
+'' - for loops with direction known only at runtime compute their trip
+''   count once and emit the body once
+'' - zero step skips the loop
+''
+'' IR-FLAGS: -O0
+''
+'' IR-LABEL:    define {{.*}} @COUNT(
+'' IR:          %for.steps = udiv i32 %for.distance, %for.step
+'' IR-LABEL:    for.body:
+'' IR:          icmp eq i32 %I.0, 5
+'' IR-NOT:      icmp eq i32 %I.0, 5
+'' IR-LABEL:    for.iter:
+'' IR-NEXT:     %for.isDone = icmp eq i32 %for.counter.0, 0
+'' IR:          br i1 %for.isDone, label %for.end, label %for.body
+'' IR-LABEL:    define {{.*}} @DOWN(
+''
+'' CHECK:       1 3 7 9 -
+'' CHECK-NEXT:  9 7 3 1 -
+'' CHECK-NEXT:  {{^}}-
+'' CHECK-NEXT:  {{^}}-
+'' CHECK-NEXT:  {{^}}-
+'' CHECK-NEXT:  -2147483647 -1073741824 -1 1073741822 2147483645 -
+'' CHECK-NEXT:  0 1 2 3 4 6 7 8 9 10 -
+'' CHECK-NEXT:  3 2 1 0
+'' CHECK-NEXT:  254 255
+'' CHECK-NEXT:  (0, 1) (0, 0) (1, 1) (1, 0)
+''------------------------------------------------------------------------------
+import cstd
+
+sub count(first as integer, last as integer, stp as integer)
+    for i = first to last step stp
+        if i = 5 then continue for
+        if i = 11 then exit for
+        printf "%d ", i
+    next
+    printf "-\n"
+end sub
+
+sub down(first as ubyte, last as ubyte)
+    for i = first to last
+        printf "%d ", i as integer
+    next
+    printf "\n"
+end sub
+
+sub nested(first as integer, last as integer)
+    for i = first to last
+        for j = last to first
+            printf "(%d, %d) ", i, j
+        next
+    next
+    printf "\n"
+end sub
+
+count(1, 9, 2)
+count(9, 1, -2)
+count(9, 1, 2)
+count(1, 9, -2)
+count(3, 3, 0)
+count(-2147483647, 2147483647, 1073741823)
+count(0, 20, 1)
+down(3, 0)
+down(254, 255)
+nested(0, 1)
@@ -0,0 +1,33 @@
+''------------------------------------------------------------------------------
+'' test-041-overflow.bas
+'' - signed integer overflow wraps around by default
+'' - -fno-wrapv makes it undefined, so arithmetic gets nsw flags
+''
+'' IR-FLAGS: -fno-wrapv -O0
+''
+'' IR-LABEL:    define {{.*}} @CHECK(
+'' IR:          add nsw i32 %VALUE, 1
+'' IR-LABEL:    define {{.*}} @SCALE(
+'' IR:          mul nsw i32 %VALUE, %FACTOR
+''
+'' CHECK:       wraps
+'' CHECK-NEXT:  scale = -2
+''------------------------------------------------------------------------------
+import cstd
+
+sub check(value as integer)
+    ' folded to false when overflow is undefined
+    if value + 1 < value then
+        printf "wraps\n"
+    else
+        printf "does not wrap\n"
+    end if
+end sub
+
+function scale(value as integer, factor as integer) as integer
+    return value * factor
+end function
+
+check(2147483647)
+var big = 2147483647
+printf "scale = %d\n", scale(big, 2)
@@ -0,0 +1,11 @@
+''------------------------------------------------------------------------------
+'' test-042-const-array-address.bas
+'' - elements of a constant array live in read only memory,
+''   their address cannot be taken
+''
+'' ERROR:       Cannot take address
+''------------------------------------------------------------------------------
+const primes(1 to 5) as integer = {2, 3, 5, 7, 11}
+
+var p = @primes(1)
+*p = 1
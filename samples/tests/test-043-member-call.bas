@@ -0,0 +1,14 @@
+''------------------------------------------------------------------------------
+'' test-043-member-call.bas
+'' - call syntax on a member only indexes arrays
+''
+'' ERROR:       Member COUNT of type 'INTEGER PTR' is not an array
+''------------------------------------------------------------------------------
+type Counter
+    count as integer ptr
+end type
+
+var value = 1
+var c as Counter
+c.count = @value
+var n = c.count(0)
@@ -0,0 +1,12 @@
+''------------------------------------------------------------------------------
+'' test-044-inline-conflict.bas
+'' - a function cannot be both INLINE and NOINLINE
+''
+'' ERROR:       Attributes INLINE and NOINLINE are mutually exclusive
+''------------------------------------------------------------------------------
+[Inline, NoInline] _
+function twice(x as integer) as integer
+    return x * 2
+end function
+
+var n = twice(2)
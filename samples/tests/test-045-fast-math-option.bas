@@ -0,0 +1,23 @@
+''------------------------------------------------------------------------------
+'' test-045-fast-math-option.bas
+'' - -ffast-math relaxes floating point semantics of every function
+''
+'' FLAGS: -ffast-math
+'' IR-FLAGS: -O0 -ffast-math
+''
+'' IR:          define dso_local i32 @main() {{.*}}[[MAIN:#[0-9]+]]
+'' IR:          define internal double @MIX(double %A, double %B, double %C) [[FAST:#[0-9]+]]
+'' IR:          fmul fast double %A, %B
+'' IR-NEXT:     fadd fast double
+'' IR-DAG:      attributes [[MAIN]] = { {{.*}} "unsafe-fp-math"="true" }
+'' IR-DAG:      attributes [[FAST]] = { {{.*}} "approx-func-fp-math"="true" "no-infs-fp-math"="true" "no-nans-fp-math"="true" "no-signed-zeros-fp-math"="true" "unsafe-fp-math"="true" }
+''
+'' CHECK:       mix = 10
+''------------------------------------------------------------------------------
+import cstd
+
+function mix(a as double, b as double, c as double) as double
+    return a * b + c
+end function
+
+printf "mix = %g\n", mix(2.0, 3.0, 4.0)
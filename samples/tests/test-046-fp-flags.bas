@@ -0,0 +1,21 @@
+''------------------------------------------------------------------------------
+'' test-046-fp-flags.bas
+'' - individual floating point options set only their own flags
+''
+'' FLAGS: -fno-honor-nans -fassociative-math
+'' IR-FLAGS: -O0 -fno-honor-nans -fassociative-math
+''
+'' IR:          define internal double @MIX(double %A, double %B, double %C) [[FLAGS:#[0-9]+]]
+'' IR:          fmul reassoc nnan double %A, %B
+'' IR-NEXT:     fadd reassoc nnan double
+'' IR:          attributes [[FLAGS]] = { nounwind readnone willreturn "no-nans-fp-math"="true" }
+''
+'' CHECK:       mix = 10
+''------------------------------------------------------------------------------
+import cstd
+
+function mix(a as double, b as double, c as double) as double
+    return a * b + c
+end function
+
+printf "mix = %g\n", mix(2.0, 3.0, 4.0)
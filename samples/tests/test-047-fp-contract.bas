@@ -0,0 +1,21 @@
+''------------------------------------------------------------------------------
+'' test-047-fp-contract.bas
+'' - -ffp-contract=fast allows fusing multiply and add, nothing else
+''
+'' FLAGS: -ffp-contract=fast
+'' IR-FLAGS: -O0 -ffp-contract=fast
+''
+'' IR:          define internal double @MIX(double %A, double %B, double %C) [[STRICT:#[0-9]+]]
+'' IR:          fmul contract double %A, %B
+'' IR-NEXT:     fadd contract double
+'' IR:          attributes [[STRICT]] = { nounwind readnone willreturn }
+''
+'' CHECK:       mix = 10
+''------------------------------------------------------------------------------
+import cstd
+
+function mix(a as double, b as double, c as double) as double
+    return a * b + c
+end function
+
+printf "mix = %g\n", mix(2.0, 3.0, 4.0)
@@ -12,6 +12,18 @@ constexpr std::array nodes {
     AST_CONTENT_NODES(KIND_ENUM)
 #undef KIND_ENUM
 };
+
+constexpr std::array intrinsics {
+#define INTRINSIC_NAME(id, name, ...) llvm::StringLiteral{ name },
+    AST_INTRINSICS(INTRINSIC_NAME)
+#undef INTRINSIC_NAME
+};
+
+constexpr std::array intrinsicArgs {
+#define INTRINSIC_ARGS(id, name, args) size_t{ args },
+    AST_INTRINSICS(INTRINSIC_ARGS)
+#undef INTRINSIC_ARGS
+};
 } // namespace literals
 
 StringRef AstRoot::getClassName() const noexcept {
@@ -37,9 +49,51 @@ std::optional<StringRef> AstAttributeList::getStringLiteral(StringRef key) const
     return "";
 }
 
+std::optional<uint64_t> AstAttributeList::getIntegerLiteral(StringRef key) const noexcept {
+    for (const auto& attr : attribs) {
+        if (attr->identExpr->name == key) {
+            if (attr->args == nullptr || attr->args->exprs.size() != 1) {
+                fatalError("Attribute "_t + key + " must have 1 value", false);
+            }
+            if (auto* literal = dyn_cast<AstLiteralExpr>(attr->args->exprs[0])) {
+                if (const auto* value = std::get_if<uint64_t>(&literal->value)) {
+                    return *value;
+                }
+            }
+            fatalError("Attribute "_t + key + " must be an integer literal", false);
+        }
+    }
+    return std::nullopt;
+}
+
 bool AstAttributeList::exists(StringRef name) const noexcept {
     auto iter = std::find_if(attribs.begin(), attribs.end(), [&](const auto& attr) {
         return attr->identExpr->name == name;
     });
     return iter != attribs.end();
 }
+
+bool AstArrayExpr::isConstant() const noexcept {
+    return std::all_of(elements.begin(), elements.end(), [](const AstExpr* element) {
+        if (const auto* array = dyn_cast<AstArrayExpr>(element)) {
+            return array->isConstant();
+        }
+        return isa<AstLiteralExpr>(element);
+    });
+}
+
+std::optional<IntrinsicKind> AstIntrinsicExpr::find(StringRef name) noexcept {
+    return llvm::StringSwitch<std::optional<IntrinsicKind>>(name)
+#define INTRINSIC_CASE(id, name, ...) .Case(name, IntrinsicKind::id)
+        AST_INTRINSICS(INTRINSIC_CASE)
+#undef INTRINSIC_CASE
+        .Default(std::nullopt);
+}
+
+StringRef AstIntrinsicExpr::getName(IntrinsicKind intrinsic) noexcept {
+    return literals::intrinsics.at(static_cast<size_t>(intrinsic));
+}
+
+size_t AstIntrinsicExpr::getArgCount(IntrinsicKind intrinsic) noexcept {
+    return literals::intrinsicArgs.at(static_cast<size_t>(intrinsic));
+}
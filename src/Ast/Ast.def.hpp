@@ -37,15 +37,18 @@
     _( IfStmt           ) \
     _( ForStmt          ) \
     _( DoLoopStmt       ) \
-    _( ContinuationStmt )
+    _( ContinuationStmt ) \
+    _( RedimStmt        ) \
+    _( AppendStmt       )
 
-#define AST_STMT_RANGE(_) _(Import, ContinuationStmt)
+#define AST_STMT_RANGE(_) _(Import, AppendStmt)
 
 //----------------------------------------
 // Declaration nodes extending AstDecl
 //----------------------------------------
 #define AST_DECL_NODES(_) \
     _( VarDecl       ) \
+    _( ConstDecl     ) \
     _( FuncDecl      ) \
     _( FuncParamDecl ) \
     _( TypeDecl      )
@@ -74,9 +77,32 @@
     _( IfExpr       ) \
     _( Dereference  ) \
     _( AddressOf    ) \
-    _( MemberAccess )
+    _( MemberAccess ) \
+    _( IndexExpr    ) \
+    _( ArrayExpr    ) \
+    _( BoundExpr    ) \
+    _( ShuffleExpr  ) \
+    _( IntrinsicExpr )
 
-#define AST_EXPR_RANGE(_) _(AssignExpr, MemberAccess)
+#define AST_EXPR_RANGE(_) _(AssignExpr, IntrinsicExpr)
+
+//----------------------------------------
+// Built-in functions lowered to LLVM intrinsics
+// id, name, number of arguments
+//----------------------------------------
+#define AST_INTRINSICS(_) \
+    _( Sqr,      "SQR",      1 ) \
+    _( Abs,      "ABS",      1 ) \
+    _( Min,      "MIN",      2 ) \
+    _( Max,      "MAX",      2 ) \
+    _( Fma,      "FMA",      3 ) \
+    _( Floor,    "FLOOR",    1 ) \
+    _( Ceil,     "CEIL",     1 ) \
+    _( PopCount, "POPCOUNT", 1 ) \
+    _( Clz,      "CLZ",      1 ) \
+    _( Ctz,      "CTZ",      1 ) \
+    _( BSwap,    "BSWAP",    1 ) \
+    _( Prefetch, "PREFETCH", 1 )
 
 //----------------------------------------
 // All content nodes
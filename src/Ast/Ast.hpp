@@ -18,6 +18,12 @@ enum class AstKind {
 #undef KIND_ENUM
 };
 
+enum class IntrinsicKind {
+#define KIND_ENUM(id, ...) id,
+    AST_INTRINSICS(KIND_ENUM)
+#undef KIND_ENUM
+};
+
 /**
  * Root class for all AST nodes. This is an abstract class
  * and should never be used as type for ast node directly
@@ -271,6 +277,43 @@ struct AstContinuationStmt final : AstStmt {
     std::vector<ControlFlowStatement> destination;
 };
 
+struct AstRedimStmt final : AstStmt {
+    AstRedimStmt(
+        llvm::SMRange range_,
+        AstExpr* expr_,
+        AstExpr* upper_,
+        bool preserve_) noexcept
+    : AstStmt{ AstKind::RedimStmt, range_ },
+      expr{ expr_ },
+      upper{ upper_ },
+      preserve{ preserve_ } {}
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::RedimStmt;
+    }
+
+    AstExpr* expr;
+    AstExpr* upper;
+    const bool preserve;
+};
+
+struct AstAppendStmt final : AstStmt {
+    AstAppendStmt(
+        llvm::SMRange range_,
+        AstExpr* expr_,
+        AstExpr* value_) noexcept
+    : AstStmt{ AstKind::AppendStmt, range_ },
+      expr{ expr_ },
+      value{ value_ } {}
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::AppendStmt;
+    }
+
+    AstExpr* expr;
+    AstExpr* value;
+};
+
 //----------------------------------------
 // Attributes
 //----------------------------------------
@@ -288,6 +331,7 @@ struct AstAttributeList final : AstRoot {
 
     [[nodiscard]] bool exists(StringRef name) const noexcept;
     [[nodiscard]] std::optional<StringRef> getStringLiteral(StringRef key) const noexcept;
+    [[nodiscard]] std::optional<uint64_t> getIntegerLiteral(StringRef key) const noexcept;
 
     std::vector<AstAttribute*> attribs;
 };
@@ -358,6 +402,25 @@ struct AstVarDecl final : AstDecl {
     AstExpr* expr;
 };
 
+struct AstConstDecl final : AstDecl {
+    AstConstDecl(
+        llvm::SMRange range_,
+        StringRef name_,
+        AstAttributeList* attrs_,
+        AstTypeExpr* type_,
+        AstExpr* expr_) noexcept
+    : AstDecl{ AstKind::ConstDecl, range_, name_, attrs_ },
+      typeExpr{ type_ },
+      expr{ expr_ } {};
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::ConstDecl;
+    }
+
+    AstTypeExpr* typeExpr;
+    AstExpr* expr;
+};
+
 struct AstFuncDecl final : AstDecl {
     AstFuncDecl(
         llvm::SMRange range_,
@@ -430,16 +493,28 @@ struct AstTypeDecl final : AstDecl {
 //----------------------------------------
 // Types
 //----------------------------------------
+
+// `lower TO upper` or just `upper` with lower bound 0.
+// Empty bound, `()`, declares a dynamic array
+struct AstArrayBound final {
+    AstExpr* lower;
+    AstExpr* upper;
+};
+
 struct AstTypeExpr final : AstRoot {
     AstTypeExpr(
         llvm::SMRange range_,
         AstIdentExpr* ident_,
         TokenKind tokenKind_,
-        int deref) noexcept
+        int deref,
+        std::vector<AstArrayBound> bounds_ = {},
+        AstExpr* lanes_ = nullptr) noexcept
     : AstRoot{ AstKind::TypeExpr, range_ },
       ident{ ident_ },
       tokenKind{ tokenKind_ },
-      dereference{ deref } {};
+      dereference{ deref },
+      bounds{ std::move(bounds_) },
+      lanes{ lanes_ } {};
 
     constexpr static bool classof(const AstRoot* ast) noexcept {
         return ast->kind == AstKind::TypeExpr;
@@ -449,6 +524,8 @@ struct AstTypeExpr final : AstRoot {
     AstIdentExpr* ident;
     const TokenKind tokenKind;
     const int dereference;
+    std::vector<AstArrayBound> bounds;
+    AstExpr* lanes; // VECTOR(lanes)
     const TypeRoot* type = nullptr;
 };
 
@@ -603,6 +680,103 @@ struct AstMemberAccess final : AstExpr {
     AstExpr* rhs;
 };
 
+struct AstIndexExpr final : AstExpr {
+    AstIndexExpr(
+        llvm::SMRange range_,
+        AstExpr* expr_,
+        AstExpr* index_) noexcept
+    : AstExpr{ AstKind::IndexExpr, range_ },
+      expr{ expr_ },
+      index{ index_ } {};
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::IndexExpr;
+    }
+
+    AstExpr* expr;
+    AstExpr* index;
+};
+
+struct AstArrayExpr final : AstExpr {
+    AstArrayExpr(
+        llvm::SMRange range_,
+        std::vector<AstExpr*> elements_) noexcept
+    : AstExpr{ AstKind::ArrayExpr, range_ },
+      elements{ std::move(elements_) } {};
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::ArrayExpr;
+    }
+
+    /// All elements are literals or constant arrays
+    [[nodiscard]] bool isConstant() const noexcept;
+
+    std::vector<AstExpr*> elements;
+};
+
+// LBOUND(a) or UBOUND(a)
+struct AstBoundExpr final : AstExpr {
+    AstBoundExpr(
+        llvm::SMRange range_,
+        TokenKind tokenKind_,
+        AstExpr* expr_) noexcept
+    : AstExpr{ AstKind::BoundExpr, range_ },
+      tokenKind{ tokenKind_ },
+      expr{ expr_ } {};
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::BoundExpr;
+    }
+
+    const TokenKind tokenKind;
+    AstExpr* expr;
+};
+
+// SHUFFLE(a, b, { lanes }) or SHUFFLE(a, { lanes })
+struct AstShuffleExpr final : AstExpr {
+    AstShuffleExpr(
+        llvm::SMRange range_,
+        AstExpr* lhs_,
+        AstExpr* rhs_,
+        AstArrayExpr* maskExpr_) noexcept
+    : AstExpr{ AstKind::ShuffleExpr, range_ },
+      lhs{ lhs_ },
+      rhs{ rhs_ },
+      maskExpr{ maskExpr_ } {};
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::ShuffleExpr;
+    }
+
+    AstExpr* lhs;
+    AstExpr* rhs;
+    AstArrayExpr* maskExpr;
+    std::vector<int> mask{}; // lanes of lhs followed by lanes of rhs
+};
+
+// Built-in function call, e.g. SQR(x)
+struct AstIntrinsicExpr final : AstExpr {
+    AstIntrinsicExpr(
+        llvm::SMRange range_,
+        IntrinsicKind intrinsic_,
+        AstExprList* args_) noexcept
+    : AstExpr{ AstKind::IntrinsicExpr, range_ },
+      intrinsic{ intrinsic_ },
+      args{ args_ } {};
+
+    constexpr static bool classof(const AstRoot* ast) noexcept {
+        return ast->kind == AstKind::IntrinsicExpr;
+    }
+
+    /// Find intrinsic by its uppercase name
+    [[nodiscard]] static std::optional<IntrinsicKind> find(StringRef name) noexcept;
+    [[nodiscard]] static StringRef getName(IntrinsicKind intrinsic) noexcept;
+    [[nodiscard]] static size_t getArgCount(IntrinsicKind intrinsic) noexcept;
+
+    const IntrinsicKind intrinsic;
+    AstExprList* args;
+};
+
 struct AstBinaryExpr final : AstExpr {
     AstBinaryExpr(
         llvm::SMRange range_,
@@ -81,6 +81,16 @@ void AstPrinter::visit(AstVarDecl& ast) {
     });
 }
 
+void AstPrinter::visit(AstConstDecl& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        writeAttributes(ast.attributes);
+        m_json.attribute("id", ast.name);
+        writeType(ast.typeExpr);
+        writeExpr(ast.expr);
+    });
+}
+
 void AstPrinter::visit(AstFuncDecl& ast) {
     m_json.object([&] {
         writeHeader(ast);
@@ -271,6 +281,25 @@ void AstPrinter::visit(AstContinuationStmt& ast) {
     });
 }
 
+void AstPrinter::visit(AstRedimStmt& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        if (ast.preserve) {
+            m_json.attribute("op", "PRESERVE");
+        }
+        writeExpr(ast.expr);
+        writeExpr(ast.upper, "upper");
+    });
+}
+
+void AstPrinter::visit(AstAppendStmt& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        writeExpr(ast.expr);
+        writeExpr(ast.value, "value");
+    });
+}
+
 void AstPrinter::visit(AstAttributeList& ast) {
     m_json.array([&] {
         for (const auto& attr : ast.attribs) {
@@ -379,6 +408,53 @@ void AstPrinter::visit(AstMemberAccess& ast) {
     });
 }
 
+void AstPrinter::visit(AstIndexExpr& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        writeExpr(ast.expr, "expr");
+        writeExpr(ast.index, "index");
+    });
+}
+
+void AstPrinter::visit(AstArrayExpr& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        m_json.attributeArray("elements", [&] {
+            for (const auto& element : ast.elements) {
+                visit(*element);
+            }
+        });
+    });
+}
+
+void AstPrinter::visit(AstBoundExpr& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        m_json.attribute("op", Token::description(ast.tokenKind));
+        writeExpr(ast.expr);
+    });
+}
+
+void AstPrinter::visit(AstShuffleExpr& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        writeExpr(ast.lhs, "lhs");
+        writeExpr(ast.rhs, "rhs");
+        writeExpr(ast.maskExpr, "mask");
+    });
+}
+
+void AstPrinter::visit(AstIntrinsicExpr& ast) {
+    m_json.object([&] {
+        writeHeader(ast);
+        m_json.attribute("intrinsic", AstIntrinsicExpr::getName(ast.intrinsic));
+
+        m_json.attributeBegin("args");
+        visit(*ast.args);
+        m_json.attributeEnd();
+    });
+}
+
 void AstPrinter::visit(AstBinaryExpr& ast) {
     m_json.object([&] {
         writeHeader(ast);
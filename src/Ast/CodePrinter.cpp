@@ -79,6 +79,11 @@ void CodePrinter::visit(AstAttribute& ast) {
 
 void CodePrinter::visit(AstTypeExpr& ast) {
     m_os << Token::description(ast.tokenKind);
+    if (ast.lanes != nullptr) {
+        m_os << " VECTOR(";
+        visit(*ast.lanes);
+        m_os << ')';
+    }
 }
 
 // Declarations
@@ -101,6 +106,7 @@ void CodePrinter::visit(AstVarDecl& ast) {
         m_os << "VAR ";
     }
     m_os << ast.name;
+    printBounds(ast.typeExpr);
 
     if (ast.typeExpr != nullptr) {
         m_os << " AS ";
@@ -113,6 +119,24 @@ void CodePrinter::visit(AstVarDecl& ast) {
     }
 }
 
+void CodePrinter::visit(AstConstDecl& ast) {
+    if (ast.attributes != nullptr) {
+        visit(*ast.attributes);
+        m_os << " _" << '\n';
+    }
+
+    m_os << indent() << "CONST " << ast.name;
+    printBounds(ast.typeExpr);
+
+    if (ast.typeExpr != nullptr) {
+        m_os << " AS ";
+        visit(*ast.typeExpr);
+    }
+
+    m_os << " = ";
+    visit(*ast.expr);
+}
+
 void CodePrinter::visit(AstFuncDecl& ast) {
     if (ast.attributes != nullptr) {
         visit(*ast.attributes);
@@ -154,6 +178,7 @@ void CodePrinter::visit(AstFuncDecl& ast) {
 
 void CodePrinter::visit(AstFuncParamDecl& ast) {
     m_os << ast.name;
+    printBounds(ast.typeExpr);
     m_os << " AS ";
     visit(*ast.typeExpr);
 }
@@ -344,6 +369,24 @@ void CodePrinter::visit(AstContinuationStmt& ast) {
     }
 }
 
+void CodePrinter::visit(AstRedimStmt& ast) {
+    m_os << indent() << "REDIM ";
+    if (ast.preserve) {
+        m_os << "PRESERVE ";
+    }
+    visit(*ast.expr);
+    m_os << '(';
+    visit(*ast.upper);
+    m_os << ')';
+}
+
+void CodePrinter::visit(AstAppendStmt& ast) {
+    m_os << indent() << "APPEND ";
+    visit(*ast.expr);
+    m_os << ", ";
+    visit(*ast.value);
+}
+
 // Expressions
 
 void CodePrinter::visit(AstIdentExpr& ast) {
@@ -418,6 +461,53 @@ void CodePrinter::visit(AstMemberAccess& ast) {
     visit(*ast.rhs);
 }
 
+void CodePrinter::visit(AstIndexExpr& ast) {
+    visit(*ast.expr);
+    m_os << '(';
+    visit(*ast.index);
+    m_os << ')';
+}
+
+void CodePrinter::visit(AstArrayExpr& ast) {
+    m_os << '{';
+    bool isFirst = true;
+    for (const auto& element : ast.elements) {
+        if (isFirst) {
+            isFirst = false;
+        } else {
+            m_os << ", ";
+        }
+        visit(*element);
+    }
+    m_os << '}';
+}
+
+void CodePrinter::visit(AstBoundExpr& ast) {
+    Token token;
+    token.set(ast.tokenKind, ast.range);
+    m_os << token.description() << '(';
+    visit(*ast.expr);
+    m_os << ')';
+}
+
+void CodePrinter::visit(AstShuffleExpr& ast) {
+    m_os << "SHUFFLE(";
+    visit(*ast.lhs);
+    if (ast.rhs != nullptr) {
+        m_os << ", ";
+        visit(*ast.rhs);
+    }
+    m_os << ", ";
+    visit(*ast.maskExpr);
+    m_os << ')';
+}
+
+void CodePrinter::visit(AstIntrinsicExpr& ast) {
+    m_os << AstIntrinsicExpr::getName(ast.intrinsic) << "(";
+    visit(*ast.args);
+    m_os << ")";
+}
+
 void CodePrinter::visit(AstBinaryExpr& ast) {
     m_os << "(";
     visit(*ast.lhs);
@@ -457,6 +547,29 @@ void CodePrinter::visit(AstIfExpr& ast) {
     m_os << ")";
 }
 
+void CodePrinter::printBounds(AstTypeExpr* ast) {
+    if (ast == nullptr || ast->bounds.empty()) {
+        return;
+    }
+    m_os << '(';
+    bool isFirst = true;
+    for (const auto& bound : ast->bounds) {
+        if (isFirst) {
+            isFirst = false;
+        } else {
+            m_os << ", ";
+        }
+        if (bound.lower != nullptr) {
+            visit(*bound.lower);
+            m_os << " TO ";
+        }
+        if (bound.upper != nullptr) {
+            visit(*bound.upper);
+        }
+    }
+    m_os << ')';
+}
+
 string CodePrinter::indent() const noexcept {
     return string(m_indent * SPACES, ' ');
 }
@@ -13,6 +13,7 @@ public:
 
 private:
     [[nodiscard]] string indent() const noexcept;
+    void printBounds(AstTypeExpr* ast);
     size_t m_indent = 0;
     llvm::raw_ostream& m_os;
     static constexpr auto SPACES = 4;
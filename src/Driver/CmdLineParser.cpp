@@ -59,6 +59,53 @@ void CmdLineParser::processOption(const Args& args, size_t& index) {
         m_options.setOptimizationLevel(CompileOptions::OptimizationLevel::O2);
     } else if (arg == "-O3") {
         m_options.setOptimizationLevel(CompileOptions::OptimizationLevel::O3);
+    } else if (arg == "-fwrapv") {
+        m_options.setOverflowMode(CompileOptions::OverflowMode::Wrap);
+    } else if (arg == "-fno-wrapv") {
+        m_options.setOverflowMode(CompileOptions::OverflowMode::Undefined);
+    } else if (arg == "-ftrapv") {
+        m_options.setOverflowMode(CompileOptions::OverflowMode::Trap);
+    } else if (arg == "-freorder-fields") {
+        m_options.setReorderFields(true);
+    } else if (arg == "-Wpadded") {
+        m_options.setWarnPadded(true);
+    } else if (auto fastMath = getFastMathFlags(arg)) {
+        auto flags = m_options.getFastMathFlags();
+        flags |= *fastMath;
+        m_options.setFastMathFlags(flags);
+    } else if (arg.startswith("-ffp-contract=")) {
+        auto mode = arg.split('=').second;
+        auto flags = m_options.getFastMathFlags();
+        if (mode == "fast") {
+            flags.setAllowContract(true);
+        } else if (mode == "off") {
+            flags.setAllowContract(false);
+        } else {
+            showError("Unsupported -ffp-contract mode "s + mode.str() + ", use fast or off.");
+        }
+        m_options.setFastMathFlags(flags);
+    } else if (arg == "-fprofile-generate" || arg.startswith("-fprofile-generate=")) {
+        m_options.setProfile(CompileOptions::ProfileMode::Generate, arg.split('=').second.str());
+    } else if (arg.startswith("-fprofile-use=")) {
+        m_options.setProfile(CompileOptions::ProfileMode::Use, arg.split('=').second.str());
+    } else if (arg.startswith("-march=") || arg.startswith("-mcpu=")) {
+        auto cpu = arg.split('=').second;
+        if (cpu.empty()) {
+            showError("target cpu missing.");
+        }
+        m_options.setTargetCpu(cpu);
+    } else if (arg.startswith("-mattr=")) {
+        m_options.setTargetFeatures(arg.split('=').second);
+    } else if (arg == "-j") {
+        index++;
+        if (index >= args.size()) {
+            showError("number of jobs missing.");
+        }
+        unsigned jobs = 0;
+        if (StringRef{ args[index] }.getAsInteger(10, jobs) || jobs == 0) {
+            showError("invalid number of jobs.");
+        }
+        m_options.setCodegenJobs(jobs);
     } else if (arg == "-c") {
         m_options.setCompilationTarget(CompileOptions::CompilationTarget::Object);
     } else if (arg == "-S") {
@@ -90,6 +137,35 @@ void CmdLineParser::processOption(const Args& args, size_t& index) {
     }
 }
 
+/**
+ * Options relaxing floating point semantics follow gcc and clang,
+ * each one adds to flags given before it
+ */
+std::optional<llvm::FastMathFlags> CmdLineParser::getFastMathFlags(StringRef arg) {
+    llvm::FastMathFlags flags;
+    if (arg == "-ffast-math") {
+        flags.setFast();
+    } else if (arg == "-ffinite-math-only") {
+        flags.setNoNaNs();
+        flags.setNoInfs();
+    } else if (arg == "-fno-honor-nans") {
+        flags.setNoNaNs();
+    } else if (arg == "-fno-honor-infinities") {
+        flags.setNoInfs();
+    } else if (arg == "-fno-signed-zeros") {
+        flags.setNoSignedZeros();
+    } else if (arg == "-fassociative-math") {
+        flags.setAllowReassoc();
+    } else if (arg == "-freciprocal-math") {
+        flags.setAllowReciprocal();
+    } else if (arg == "-fapprox-func") {
+        flags.setApproxFunc();
+    } else {
+        return std::nullopt;
+    }
+    return flags;
+}
+
 //void CmdLineParser::processToolchainPath(const fs::path& path) {
 //    if (path.is_absolute()) {
 //        if (fs::exists(path)) {
@@ -133,8 +209,29 @@ OPTIONS:
     -code-dump       Dump AST as source code
     -o <file>        Write output to <file>
     -O<number>       Set optimization. Valid options: O0, OS, O1, O2, O3
+    -fwrapv          Signed integer overflow wraps around (default)
+    -fno-wrapv       Signed integer overflow is undefined behaviour
+    -ftrapv          Trap on signed integer overflow
+    -freorder-fields Sort TYPE members by alignment to minimize padding
+    -Wpadded         Warn about TYPEs that contain padding
+    -ffast-math      Enable all floating point optimizations below
+    -ffinite-math-only    Assume no NaNs or infinities
+    -fno-honor-nans       Assume no NaNs (nnan)
+    -fno-honor-infinities Assume no infinities (ninf)
+    -fno-signed-zeros     Ignore sign of zero (nsz)
+    -fassociative-math    Allow reassociation, needed to vectorize reductions (reassoc)
+    -freciprocal-math     Allow x / y to become x * (1 / y) (arcp)
+    -fapprox-func         Allow approximate math functions (afn)
+    -ffp-contract=<mode>  Fuse multiply and add: fast or off (default)
+    -fprofile-generate[=<dir>]
+                     Instrument code to write execution profile into <dir>
+    -fprofile-use=<path>  Optimize using profile merged by llvm-profdata
+    -j <number>      Optimize whole modules, then split code into <number> partitions assembled in parallel
     -m32             Generate 32bit i386 code
     -m64             Generate 64bit x86-64 code
+    -march=<cpu>     Generate code for <cpu>, `native` selects the host CPU
+    -mcpu=<cpu>      Same as -march
+    -mattr=<a1,-a2>  Enable (+) or disable (-) target features, e.g. +avx2,-fma
     -toolchain <Dir> Path to LLVM toolchain
     -main <file>     File which will have implicit `main` function
     -no-main         Do not generate implicit `main` function
@@ -23,6 +23,7 @@ public:
 
 private:
     void processOption(const Args& args, size_t& index);
+    [[nodiscard]] static std::optional<llvm::FastMathFlags> getFastMathFlags(StringRef arg);
 
     [[noreturn]] static void showError(const string& message);
     [[noreturn]] static void showHelp();
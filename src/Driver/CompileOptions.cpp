@@ -3,6 +3,7 @@
 //
 using namespace lbc;
 #include "CompileOptions.hpp"
+#include <llvm/Support/Host.h>
 
 string CompileOptions::getFileExt(FileType type) {
     switch (type) {
@@ -44,6 +45,17 @@ void CompileOptions::validate() const noexcept {
         fatalError("cannot specify -o when generating multiple output files.");
     }
 
+    if (m_profileMode == ProfileMode::Use && m_profilePath.empty()) {
+        fatalError("-fprofile-use requires a profile path");
+    }
+
+    // profile runtime is not shipped with the Windows toolchain
+    if (m_profileMode == ProfileMode::Generate && isTargetLinkable()) {
+        if (llvm::Triple{ llvm::sys::getDefaultTargetTriple() }.isOSWindows()) {
+            fatalError("-fprofile-generate is not supported for Windows targets");
+        }
+    }
+
     if (m_outputType == OutputType::LLVM && isTargetNative()) {
         fatalError("flag -emit-llvm must be combined with -S or -c");
     }
@@ -26,6 +26,18 @@ public:
         O3
     };
 
+    enum class OverflowMode {
+        Wrap,      // signed arithmetic wraps around
+        Undefined, // signed overflow is undefined behaviour
+        Trap       // signed overflow aborts the program
+    };
+
+    enum class ProfileMode {
+        None,
+        Generate, // instrument code to write a raw profile
+        Use       // optimize using a merged .profdata
+    };
+
     enum class FileType {
         Source,   // anything, but mostly .bas
         Assembly, // .s
@@ -69,12 +81,43 @@ public:
     [[nodiscard]] OptimizationLevel getOptimizationLevel() const noexcept { return m_optimizationLevel; }
     void setOptimizationLevel(OptimizationLevel level) noexcept { m_optimizationLevel = level; }
 
+    [[nodiscard]] OverflowMode getOverflowMode() const noexcept { return m_overflowMode; }
+    void setOverflowMode(OverflowMode mode) noexcept { m_overflowMode = mode; }
+
+    [[nodiscard]] bool getReorderFields() const noexcept { return m_reorderFields; }
+    void setReorderFields(bool reorder) noexcept { m_reorderFields = reorder; }
+
+    [[nodiscard]] bool getWarnPadded() const noexcept { return m_warnPadded; }
+    void setWarnPadded(bool warn) noexcept { m_warnPadded = warn; }
+
+    /// CPU name, or "native" for the host CPU. Empty selects target default
+    [[nodiscard]] StringRef getTargetCpu() const noexcept { return m_targetCpu; }
+    void setTargetCpu(StringRef cpu) { m_targetCpu = cpu.str(); }
+
+    /// Comma separated list of +feature / -feature
+    [[nodiscard]] StringRef getTargetFeatures() const noexcept { return m_targetFeatures; }
+    void setTargetFeatures(StringRef features) { m_targetFeatures = features.str(); }
+
+    /// Floating point semantics relaxed for the whole program
+    [[nodiscard]] llvm::FastMathFlags getFastMathFlags() const noexcept { return m_fastMathFlags; }
+    void setFastMathFlags(llvm::FastMathFlags flags) noexcept { m_fastMathFlags = flags; }
+
+    [[nodiscard]] ProfileMode getProfileMode() const noexcept { return m_profileMode; }
+    [[nodiscard]] const fs::path& getProfilePath() const noexcept { return m_profilePath; }
+    void setProfile(ProfileMode mode, const fs::path& path) {
+        m_profileMode = mode;
+        m_profilePath = path;
+    }
+
     [[nodiscard]] bool isDebugBuild() const noexcept { return m_isDebug; }
     void setDebugBuild(bool debug) noexcept { m_isDebug = debug; }
 
     [[nodiscard]] bool isVerbose() const noexcept { return m_verbose; }
     void setVerbose(bool verbose) noexcept { m_verbose = verbose; }
 
+    [[nodiscard]] unsigned getCodegenJobs() const noexcept { return m_codegenJobs; }
+    void setCodegenJobs(unsigned jobs) noexcept { m_codegenJobs = jobs; }
+
     [[nodiscard]] bool getImplicitMain() const noexcept { return m_implicitMain; }
     void setImplicitMain(bool implicitMain) noexcept { m_implicitMain = implicitMain; }
 
@@ -124,10 +167,19 @@ private:
     CompilationTarget m_compilationTarget = CompilationTarget::Executable;
     bool m_is64bit = true;
     OptimizationLevel m_optimizationLevel = OptimizationLevel::O2;
+    OverflowMode m_overflowMode = OverflowMode::Wrap;
+    bool m_reorderFields = false;
+    bool m_warnPadded = false;
+    string m_targetCpu{};
+    string m_targetFeatures{};
+    llvm::FastMathFlags m_fastMathFlags{};
+    ProfileMode m_profileMode = ProfileMode::None;
+    fs::path m_profilePath{};
     bool m_implicitMain = true;
     bool m_isDebug = false;
     bool m_astDump = false;
     bool m_codeDump = false;
+    unsigned m_codegenJobs = 1;
     std::optional<fs::path> m_mainPath{};
     std::array<std::vector<fs::path>, FILETYPE_COUNT> m_inputFiles{};
     fs::path m_outputPath{};
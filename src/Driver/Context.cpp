@@ -5,9 +5,45 @@
 #include "CompileOptions.hpp"
 #include "Diag/DiagnosticEngine.hpp"
 #include "Driver/Toolchain/Toolchain.hpp"
+#include "Type/Type.hpp"
+#include <llvm/MC/MCSubtargetInfo.h>
 #include <llvm/Support/Host.h>
+#include <llvm/Support/X86TargetParser.h>
+#include <llvm/Support/TargetSelect.h>
+#include <llvm/Target/TargetMachine.h>
+#if LLVM_VERSION_MAJOR >= 14
+#    include <llvm/MC/TargetRegistry.h>
+#else
+#    include <llvm/Support/TargetRegistry.h>
+#endif
 using namespace lbc;
 
+namespace {
+/**
+ * opt and llc abort with a stack dump on a CPU they do not know,
+ * or one that cannot run code for the triple, report it upfront
+ */
+void validateTarget(const llvm::Target& target, const llvm::Triple& triple, StringRef cpu, StringRef features) {
+    if (!cpu.empty()) {
+        std::unique_ptr<llvm::MCSubtargetInfo> info{ target.createMCSubtargetInfo(triple.str(), "", "") };
+        if (!info->isCPUStringValid(cpu)) {
+            fatalError("Unknown target CPU '"_t + cpu + "'");
+        }
+        if (triple.isX86() && cpu != "generic" && llvm::X86::parseArchX86(cpu, triple.isArch64Bit()) == llvm::X86::CK_None) {
+            fatalError("Target CPU '"_t + cpu + "' does not support " + triple.getArchName());
+        }
+    }
+
+    llvm::SmallVector<StringRef, 8> list;
+    features.split(list, ',', -1, false);
+    for (auto feature : list) {
+        if (!feature.startswith("+") && !feature.startswith("-")) {
+            fatalError("Invalid target feature '"_t + feature + "', expected +feature or -feature");
+        }
+    }
+}
+} // namespace
+
 struct Context::Pimpl {
     Pimpl(Context& context) noexcept
     : diag{ context },
@@ -29,6 +65,37 @@ Context::Context(const CompileOptions& options)
         m_triple = m_triple.get32BitArchVariant();
     }
 
+    // data layout differs between 32 and 64 bit, ask the target for it
+    llvm::InitializeNativeTarget();
+    string error;
+    const auto* target = llvm::TargetRegistry::lookupTarget(m_triple.str(), error);
+    if (target == nullptr) {
+        fatalError("Unsupported target "_t + m_triple.str() + ": " + error);
+    }
+    std::unique_ptr<llvm::TargetMachine> machine{
+        target->createTargetMachine(m_triple.str(), "", "", {}, llvm::None)
+    };
+    m_dataLayout = machine->createDataLayout();
+
+    // resolve `native` once, so that generated code and tools agree
+    m_targetCpu = m_options.getTargetCpu().str();
+    std::vector<string> features;
+    if (m_targetCpu == "native") {
+        m_targetCpu = llvm::sys::getHostCPUName().str();
+        llvm::StringMap<bool> hostFeatures;
+        if (llvm::sys::getHostCPUFeatures(hostFeatures)) {
+            for (const auto& feature : hostFeatures) {
+                features.emplace_back((feature.second ? "+" : "-") + feature.first().str());
+            }
+            std::sort(features.begin(), features.end());
+        }
+    }
+    if (!m_options.getTargetFeatures().empty()) {
+        features.emplace_back(m_options.getTargetFeatures().str());
+    }
+    m_targetFeatures = llvm::join(features, ",");
+    validateTarget(*target, m_triple, m_targetCpu, m_options.getTargetFeatures());
+
     if (!m_options.getToolchainDir().empty()) {
         m_toolchain.setBasePath(m_options.getToolchainDir());
     }
@@ -2,12 +2,20 @@
 // Created by Albert Varaksin on 18/04/2021.
 //
 #pragma once
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/FoldingSet.h"
+#include "llvm/IR/DataLayout.h"
 #include "llvm/Support/Allocator.h"
+#include <mutex>
 
 namespace lbc {
 class CompileOptions;
+class TypeArray;
+class TypeDynamicArray;
 class TypeFunction;
 class TypePointer;
+class TypeRoot;
+class TypeVector;
 class DiagnosticEngine;
 class Toolchain;
 
@@ -27,6 +35,9 @@ public:
     [[nodiscard]] DiagnosticEngine& getDiag() noexcept { return m_diag; }
     [[nodiscard]] Toolchain& getToolchain() noexcept { return m_toolchain; }
     [[nodiscard]] llvm::Triple& getTriple() noexcept { return m_triple; }
+    [[nodiscard]] const llvm::DataLayout& getDataLayout() const noexcept { return m_dataLayout; }
+    [[nodiscard]] StringRef getTargetCpu() const noexcept { return m_targetCpu; }
+    [[nodiscard]] StringRef getTargetFeatures() const noexcept { return m_targetFeatures; }
     [[nodiscard]] llvm::SourceMgr& getSourceMrg() noexcept { return m_sourceMgr; }
     [[nodiscard]] llvm::LLVMContext& getLlvmContext() noexcept { return m_llvmContext; }
 
@@ -62,8 +73,27 @@ public:
         return res;
     }
 
-    llvm::SmallVector<TypeFunction*> funcTypes;
-    llvm::SmallVector<TypePointer*> ptrTypes;
+    /**
+     * Uniqued pointer, function, array, dynamic array and vector types. Lookups and insertions must
+     * hold typesMutex, types are allocated from typeAllocator so that
+     * they can be created concurrently with other allocations.
+     */
+    std::mutex typesMutex;
+    llvm::BumpPtrAllocator typeAllocator;
+    // function types own their parameter list, so they must be destroyed
+    llvm::SpecificBumpPtrAllocator<TypeFunction> funcTypeAllocator;
+    llvm::DenseMap<const TypeRoot*, TypePointer*> ptrTypes;
+    llvm::FoldingSet<TypeFunction> funcTypes;
+    llvm::FoldingSet<TypeArray> arrayTypes;
+    llvm::DenseMap<const TypeRoot*, TypeDynamicArray*> dynArrayTypes;
+    llvm::DenseMap<std::pair<const TypeRoot*, unsigned>, TypeVector*> vectorTypes;
+
+    /**
+     * LLVM types belong to the LLVMContext, so they are cached per
+     * Context rather than in the shared type objects. Only code generation
+     * uses it, on the thread that owns the LLVMContext, so it is not locked
+     */
+    llvm::DenseMap<const TypeRoot*, llvm::Type*> llvmTypes;
 
 private:
     struct Pimpl;
@@ -74,6 +104,9 @@ private:
     Toolchain& m_toolchain;
 
     llvm::Triple m_triple;
+    llvm::DataLayout m_dataLayout{ "" };
+    string m_targetCpu{};
+    string m_targetFeatures{};
     llvm::SourceMgr m_sourceMgr{};
     llvm::LLVMContext m_llvmContext{};
 
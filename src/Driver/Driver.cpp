@@ -11,8 +11,11 @@
 #include "Sem/SemanticAnalyzer.hpp"
 #include "TempFileCache.hpp"
 #include "Toolchain/ToolTask.hpp"
+#include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/IR/IRPrintingPasses.h>
 #include <llvm/Support/FileSystem.h>
+#include <llvm/Support/ThreadPool.h>
+#include <llvm/Transforms/Utils/SplitModule.h>
 
 using namespace lbc;
 
@@ -38,6 +41,7 @@ void Driver::drive() {
     case CompileOptions::CompilationTarget::Executable:
         emitBitCode(true);
         optimize();
+        splitModules();
         emitObjects(true);
         emitExecutable();
         break;
@@ -150,65 +154,154 @@ void Driver::emitNative(CompileOptions::FileType type, bool temporary) {
     }
     dstFiles.reserve(dstFiles.size() + bcFiles.size());
 
-    auto assembler = m_context.getToolchain().createTask(ToolKind::Assembler);
+    std::vector<unique_ptr<Source>> outputs;
+    outputs.reserve(bcFiles.size());
     for (const auto& source : bcFiles) {
-        auto output = deriveSource(*source, type, temporary);
+        outputs.emplace_back(deriveSource(*source, type, temporary));
+    }
 
-        assembler.reset();
+    auto failed = runTasks(ToolKind::Assembler, bcFiles.size(), [&](ToolTask& assembler, size_t index) {
         assembler.addArg("-filetype="s + filetype);
+        addTargetArgs(assembler, true);
         if (type == CompileOptions::FileType::Assembly && m_context.getTriple().isX86()) {
             assembler.addArg("--x86-asm-syntax=intel");
         }
-        assembler.addPath("-o", output->path);
-        assembler.addPath(source->path);
-
-        if (assembler.execute() != EXIT_SUCCESS) {
-            fatalError("Failed emit '"_t + output->path.string() + "'");
-        }
-
-        dstFiles.emplace_back(std::move(output));
+        assembler.addPath("-o", outputs[index]->path);
+        assembler.addPath(bcFiles[index]->path);
+    });
+    if (failed) {
+        fatalError("Failed emit '"_t + outputs[*failed]->path.string() + "'");
     }
+
+    std::move(outputs.begin(), outputs.end(), std::back_inserter(dstFiles));
 }
 
 void Driver::optimize() {
     auto level = m_options.getOptimizationLevel();
-    if (level == CompileOptions::OptimizationLevel::O0) {
+    auto profileMode = m_options.getProfileMode();
+    if (level == CompileOptions::OptimizationLevel::O0 && profileMode != CompileOptions::ProfileMode::Generate) {
         return;
     }
     bool llvmIr = m_options.isOutputLLVMIr();
     const auto& files = getSources(llvmIr ? CompileOptions::FileType::LLVMIr : CompileOptions::FileType::BitCode);
 
-    auto optimizer = m_context.getToolchain().createTask(ToolKind::Optimizer);
-    for (const auto& file : files) {
-        optimizer.reset();
+    string levelArg;
+    switch (level) {
+    case CompileOptions::OptimizationLevel::O0:
+        levelArg = "-O0";
+        break;
+    case CompileOptions::OptimizationLevel::OS:
+        levelArg = "-OS";
+        break;
+    case CompileOptions::OptimizationLevel::O1:
+        levelArg = "-O1";
+        break;
+    case CompileOptions::OptimizationLevel::O2:
+        levelArg = "-O2";
+        break;
+    case CompileOptions::OptimizationLevel::O3:
+        levelArg = "-O3";
+        break;
+    default:
+        llvm_unreachable("Unexpected optimization level");
+    }
+
+    auto failed = runTasks(ToolKind::Optimizer, files.size(), [&](ToolTask& optimizer, size_t index) {
+        const auto& file = files[index];
         if (llvmIr) {
             optimizer.addArg("-S");
         }
+        optimizer.addArg(levelArg);
+        addTargetArgs(optimizer, false);
+        addProfileArgs(optimizer);
+        optimizer.addPath("-o", file->path);
+        optimizer.addPath(file->path);
+    });
+    if (failed) {
+        fatalError("Failed to optimize "_t + files[*failed]->path.string());
+    }
+}
 
-        switch (level) {
-        case CompileOptions::OptimizationLevel::OS:
-            optimizer.addArg("-OS");
-            break;
-        case CompileOptions::OptimizationLevel::O1:
-            optimizer.addArg("-O1");
-            break;
-        case CompileOptions::OptimizationLevel::O2:
-            optimizer.addArg("-O2");
-            break;
-        case CompileOptions::OptimizationLevel::O3:
-            optimizer.addArg("-O3");
-            break;
-        default:
-            llvm_unreachable("Unexpected optimization level");
+/**
+ * Target machine of opt and llc must match the function attributes,
+ * or optimizer would cost vector code for the baseline CPU. opt appends
+ * -mattr to features functions already have, so it only gets the CPU
+ */
+void Driver::addTargetArgs(ToolTask& task, bool withFeatures) const {
+    if (auto cpu = m_context.getTargetCpu(); !cpu.empty()) {
+        task.addArg("-mcpu="s + cpu.str());
+    }
+    if (auto features = m_context.getTargetFeatures(); withFeatures && !features.empty()) {
+        task.addArg("-mattr="s + features.str());
+    }
+}
+
+/**
+ * Profile guided optimization is only wired into the new pass manager
+ * pipelines, which opt did not default to before LLVM 13
+ */
+void Driver::addProfileArgs(ToolTask& task) const {
+    const auto& path = m_options.getProfilePath();
+    switch (m_options.getProfileMode()) {
+    case CompileOptions::ProfileMode::None:
+        return;
+    case CompileOptions::ProfileMode::Generate:
+        task.addArg("--pgo-kind=pgo-instr-gen-pipeline");
+        if (!path.empty()) {
+            // %m lets runtime merge profiles of different executables
+            task.addArg("--profile-file=" + (path / "default_%m.profraw").string());
         }
-        optimizer.addPath("-o", file->path);
+        break;
+    case CompileOptions::ProfileMode::Use: {
+        auto profdata = fs::is_directory(path) ? path / "default.profdata" : path;
+        task.addArg("--pgo-kind=pgo-instr-use-pipeline");
+        task.addArg("--profile-file=" + m_options.resolveFilePath(profdata).string());
+        break;
+    }
+    }
+#if LLVM_VERSION_MAJOR < 13
+    task.addArg("--enable-new-pm");
+#endif
+}
 
-        optimizer.addPath(file->path);
+/**
+ * Run `count` configured instances of the given tool. When more than one
+ * codegen job is requested, tasks are executed in parallel.
+ *
+ * @return index of the first failed task, if any
+ */
+std::optional<size_t> Driver::runTasks(ToolKind kind, size_t count, const std::function<void(ToolTask&, size_t)>& configure) const {
+    const auto& toolchain = m_context.getToolchain();
+    std::vector<int> results(count, EXIT_SUCCESS);
+    auto run = [&](size_t index) {
+        auto task = toolchain.createTask(kind);
+        configure(task, index);
+        results[index] = task.execute();
+    };
+
+    auto jobs = std::min<size_t>(m_options.getCodegenJobs(), count);
+    if (jobs <= 1) {
+        for (size_t index = 0; index < count; index++) {
+            run(index);
+            if (results[index] != EXIT_SUCCESS) {
+                return index;
+            }
+        }
+        return std::nullopt;
+    }
+
+    llvm::ThreadPool pool{ llvm::hardware_concurrency(static_cast<unsigned>(jobs)) };
+    for (size_t index = 0; index < count; index++) {
+        pool.async(run, index);
+    }
+    pool.wait();
 
-        if (optimizer.execute() != EXIT_SUCCESS) {
-            fatalError("Failed to optimize "_t + file->path.string());
+    for (size_t index = 0; index < count; index++) {
+        if (results[index] != EXIT_SUCCESS) {
+            return index;
         }
     }
+    return std::nullopt;
 }
 
 void Driver::emitExecutable() {
@@ -245,6 +338,10 @@ void Driver::emitExecutable() {
         }
     }
 
+    // runtime support library is built for the host alongside the compiler,
+    // so it is not available for Windows targets
+    auto runtimeLib = m_options.getCompilerDir() / "lib" / "liblbcrt.a";
+
     if (triple.isOSWindows()) {
         auto sysLibPath = m_context.getToolchain().getBasePath() / "lib";
         linker
@@ -259,7 +356,6 @@ void Driver::emitExecutable() {
         for (const auto& obj : objFiles) {
             linker.addPath(obj->path);
         }
-
         linker
             .addArgs({ "-(",
                 "-lgcc",
@@ -280,6 +376,8 @@ void Driver::emitExecutable() {
         for (const auto& obj : objFiles) {
             linker.addPath(obj->path);
         }
+        addProfileRuntime(linker);
+        linker.addPath(runtimeLib);
     } else if (triple.isOSLinux()) {
         string linuxSysPath = "/usr/lib/x86_64-linux-gnu";
         linker
@@ -294,6 +392,8 @@ void Driver::emitExecutable() {
             linker.addPath(obj->path);
         }
 
+        addProfileRuntime(linker);
+        linker.addPath(runtimeLib);
         linker.addArg("-lc");
         linker.addArg(linuxSysPath + "/crtn.o");
     } else {
@@ -305,8 +405,81 @@ void Driver::emitExecutable() {
     }
 }
 
+/**
+ * Instrumented code registers itself with the runtime that writes
+ * the profile at exit, force it to be pulled from the archive
+ */
+void Driver::addProfileRuntime(ToolTask& linker) const {
+    if (m_options.getProfileMode() != CompileOptions::ProfileMode::Generate) {
+        return;
+    }
+    // Mach-O symbols carry an extra leading underscore
+    const auto* runtimeHook = m_context.getTriple().isOSBinFormatMachO()
+        ? "___llvm_profile_runtime"
+        : "__llvm_profile_runtime";
+    linker.addArg("-u", runtimeHook);
+    linker.addPath(m_context.getToolchain().getProfileRuntimePath());
+}
+
 // Compile
 
+/**
+ * Split optimized bitcode into partitions so that they can be
+ * assembled in parallel. Splitting after optimization keeps inlining
+ * across the whole module. Local symbols are kept in the same
+ * partition as their users, so partitions of different source files
+ * do not clash when linked.
+ */
+void Driver::splitModules() {
+    auto jobs = m_options.getCodegenJobs();
+    if (jobs <= 1) {
+        return;
+    }
+
+    auto& bcFiles = getSources(CompileOptions::FileType::BitCode);
+    SourceVector partitions;
+    partitions.reserve(bcFiles.size() * jobs);
+    for (auto& source : bcFiles) {
+        // inputs are the origin of sources derived from them
+        if (!source->isGenerated) {
+            partitions.emplace_back(std::move(source));
+            continue;
+        }
+
+        auto buffer = llvm::MemoryBuffer::getFile(source->path.string());
+        if (!buffer) {
+            fatalError("Failed to read '"_t + source->path.string() + "'");
+        }
+        auto module = llvm::parseBitcodeFile(buffer.get()->getMemBufferRef(), m_context.getLlvmContext());
+        if (!module) {
+            llvm::consumeError(module.takeError());
+            fatalError("Failed to parse '"_t + source->path.string() + "'");
+        }
+
+        auto add = [&](unique_ptr<llvm::Module> part) {
+            auto output = deriveSource(*source, CompileOptions::FileType::BitCode, true);
+
+            std::error_code errors{};
+            llvm::raw_fd_ostream stream{
+                output->path.string(),
+                errors,
+                llvm::sys::fs::OpenFlags::OF_None
+            };
+            llvm::WriteBitcodeToFile(*part, stream);
+            stream.flush();
+            stream.close();
+
+            partitions.emplace_back(std::move(output));
+        };
+#if LLVM_VERSION_MAJOR >= 13
+        llvm::SplitModule(**module, jobs, add, true);
+#else
+        llvm::SplitModule(std::move(*module), jobs, add, true);
+#endif
+    }
+    bcFiles = std::move(partitions);
+}
+
 void Driver::compileSources() {
     if (m_options.isVerbose()) {
         llvm::outs() << "Compile:\n";
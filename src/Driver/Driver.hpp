@@ -9,6 +9,8 @@
 
 namespace lbc {
 class Context;
+class ToolTask;
+enum class ToolKind;
 
 /**
  * Drive compilation process
@@ -38,9 +40,14 @@ private:
     void emitObjects(bool temporary);
     void emitNative(CompileOptions::FileType type, bool temporary);
     void emitExecutable();
+    void addProfileRuntime(ToolTask& linker) const;
 
     void optimize();
+    void addTargetArgs(ToolTask& task, bool withFeatures) const;
+    void addProfileArgs(ToolTask& task) const;
+    [[nodiscard]] std::optional<size_t> runTasks(ToolKind kind, size_t count, const std::function<void(ToolTask&, size_t)>& configure) const;
 
+    void splitModules();
     void compileSources();
     void compileSource(const Source* source, unsigned ID);
     void dumpAst();
@@ -6,10 +6,16 @@
 #include "Driver/Context.hpp"
 #include "Toolchain.hpp"
 
+#include <mutex>
 #include <utility>
 
 using namespace lbc;
 
+namespace {
+// tasks may execute in parallel, keep verbose output readable
+std::mutex outputMutex; // NOLINT
+} // namespace
+
 ToolTask& ToolTask::reset() {
     m_args.clear();
     return *this;
@@ -57,6 +63,7 @@ int ToolTask::execute() const noexcept {
     }
 
     if (m_context.getOptions().isVerbose()) {
+        std::lock_guard<std::mutex> lock{ outputMutex };
         switch (m_kind) {
         case ToolKind::Optimizer:
             llvm::outs() << "Optimize:\n";
@@ -2,6 +2,7 @@
 // Created by Albert Varaksin on 07/02/2021.
 //
 #include "Toolchain.hpp"
+#include "Driver/Context.hpp"
 #include "ToolTask.hpp"
 
 using namespace lbc;
@@ -35,6 +35,9 @@ public:
 
     [[nodiscard]] ToolTask createTask(ToolKind kind) const noexcept;
 
+    /// compiler-rt profile library of the LLVM installation
+    [[nodiscard]] fs::path getProfileRuntimePath() const;
+
 private:
     fs::path m_basePath{};
     Context& m_context;
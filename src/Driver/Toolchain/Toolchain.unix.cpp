@@ -34,3 +34,32 @@ fs::path Toolchain::getPath(ToolKind tool) const noexcept {
     }
     return path;
 }
+
+/**
+ * Runtime is part of clang's compiler-rt, installed under
+ * lib/clang/<version>/lib/<os> next to the tools
+ */
+fs::path Toolchain::getProfileRuntimePath() const {
+    const auto& triple = m_context.getTriple();
+    string osDir;
+    string name;
+    if (triple.isOSLinux()) {
+        osDir = "linux";
+        name = "libclang_rt.profile-"s + triple.getArchName().str() + ".a";
+    } else if (triple.isMacOSX()) {
+        osDir = "darwin";
+        name = "libclang_rt.profile_osx.a";
+    } else {
+        fatalError("Profile runtime is not available for "_t + triple.str());
+    }
+
+    auto binDir = m_basePath.empty() ? fs::path{ "/usr/local/bin" } : m_basePath;
+    auto clangDir = binDir.parent_path() / "lib" / "clang";
+    std::error_code error;
+    for (const auto& entry : fs::directory_iterator(clangDir, error)) {
+        if (auto path = entry.path() / "lib" / osDir / name; fs::exists(path)) {
+            return path;
+        }
+    }
+    fatalError("Profile runtime "_t + name + " not found in " + clangDir.string());
+}
@@ -22,3 +22,7 @@ fs::path Toolchain::getPath(ToolKind tool) const noexcept {
     }
     return path;
 }
+
+fs::path Toolchain::getProfileRuntimePath() const {
+    fatalError("Profile runtime is not supported on Windows");
+}
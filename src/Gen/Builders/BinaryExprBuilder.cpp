@@ -16,6 +16,8 @@ ValueHandler BinaryExprBuilder::build() {
         return logical();
     case OperatorType::Comparison:
         return comparison();
+    case OperatorType::Bitwise:
+        return shift();
     default:
         llvm_unreachable("invalid operator type");
     }
@@ -34,13 +36,66 @@ ValueHandler BinaryExprBuilder::arithmetic() {
     auto* lhsValue = m_gen.visit(*m_ast.lhs).load();
     auto* rhsValue = m_gen.visit(*m_ast.rhs).load();
 
-    auto op = getBinOpPred(m_ast.lhs->type, m_ast.tokenKind);
-    return { &m_gen, m_builder.CreateBinOp(op, lhsValue, rhsValue) };
+    if (m_ast.lhs->type->isPointer() || m_ast.rhs->type->isPointer()) {
+        return pointerArithmetic(lhsValue, rhsValue);
+    }
+
+    const auto* ty = m_ast.lhs->type;
+    auto op = getBinOpPred(ty, m_ast.tokenKind);
+    return { &m_gen, m_gen.createBinOp(op, lhsValue, rhsValue, ty) };
+}
+
+/**
+ * Offsets are scaled by the element alloc size from the target DataLayout
+ */
+ValueHandler BinaryExprBuilder::pointerArithmetic(llvm::Value* lhsValue, llvm::Value* rhsValue) {
+    const auto& dataLayout = m_builder.GetInsertBlock()->getModule()->getDataLayout();
+    auto* intPtrTy = dataLayout.getIntPtrType(m_llvmContext);
+
+    // p - q
+    if (m_ast.lhs->type->isPointer() && m_ast.rhs->type->isPointer()) {
+        const auto* base = llvm::cast<TypePointer>(m_ast.lhs->type)->getBase();
+        auto size = dataLayout.getTypeAllocSize(base->getLlvmType(m_gen.getContext())).getFixedSize();
+        auto* diff = m_builder.CreateSub(
+            m_builder.CreatePtrToInt(lhsValue, intPtrTy),
+            m_builder.CreatePtrToInt(rhsValue, intPtrTy));
+        auto* distance = m_builder.CreateExactSDiv(diff, llvm::ConstantInt::get(intPtrTy, size));
+        return { &m_gen, m_builder.CreateIntCast(distance, m_ast.type->getLlvmType(m_gen.getContext()), true) };
+    }
+
+    // p + n, n + p, p - n
+    const bool lhsIsPointer = m_ast.lhs->type->isPointer();
+    auto* pointer = lhsIsPointer ? lhsValue : rhsValue;
+    auto* offset = lhsIsPointer ? rhsValue : lhsValue;
+    const auto* offsetTy = lhsIsPointer ? m_ast.rhs->type : m_ast.lhs->type;
+
+    offset = m_builder.CreateIntCast(offset, intPtrTy, offsetTy->isSignedIntegral());
+    if (m_ast.tokenKind == TokenKind::Minus) {
+        offset = m_builder.CreateNeg(offset);
+    }
+
+    const auto* base = llvm::cast<TypePointer>(m_ast.type)->getBase();
+    return { &m_gen, m_builder.CreateInBoundsGEP(base->getLlvmType(m_gen.getContext()), pointer, offset) };
 }
 
 ValueHandler BinaryExprBuilder::logical() {
     // lhs
     auto* lhsValue = m_gen.visit(*m_ast.lhs).load();
+
+    // bitwise operators, XOR and vector lanes do not short circuit
+    if (!m_ast.type->isBoolean() || m_ast.tokenKind == TokenKind::LogicalXor) {
+        auto* rhsValue = m_gen.visit(*m_ast.rhs).load();
+        switch (m_ast.tokenKind) {
+        case TokenKind::LogicalAnd:
+            return { &m_gen, m_builder.CreateAnd(lhsValue, rhsValue) };
+        case TokenKind::LogicalOr:
+            return { &m_gen, m_builder.CreateOr(lhsValue, rhsValue) };
+        case TokenKind::LogicalXor:
+            return { &m_gen, m_builder.CreateXor(lhsValue, rhsValue) };
+        default:
+            llvm_unreachable("invalid logical operator");
+        }
+    }
     auto* lhsBlock = m_builder.GetInsertBlock();
 
     auto* func = lhsBlock->getParent();
@@ -72,3 +127,21 @@ ValueHandler BinaryExprBuilder::logical() {
     phi->addIncoming(rhsValue, rhsBlock);
     return { &m_gen, phi };
 }
+
+ValueHandler BinaryExprBuilder::shift() {
+    auto* lhsValue = m_gen.visit(*m_ast.lhs).load();
+    auto* rhsValue = m_gen.visit(*m_ast.rhs).load();
+
+    // shifting by the width or more is poison in LLVM, mask the
+    // amount like x86 does
+    auto width = lhsValue->getType()->getScalarSizeInBits();
+    rhsValue = m_builder.CreateAnd(rhsValue, llvm::ConstantInt::get(rhsValue->getType(), width - 1));
+
+    if (m_ast.tokenKind == TokenKind::ShiftLeft) {
+        return { &m_gen, m_builder.CreateShl(lhsValue, rhsValue) };
+    }
+    if (m_ast.type->getScalarType()->isSignedIntegral()) {
+        return { &m_gen, m_builder.CreateAShr(lhsValue, rhsValue) };
+    }
+    return { &m_gen, m_builder.CreateLShr(lhsValue, rhsValue) };
+}
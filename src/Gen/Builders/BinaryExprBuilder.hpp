@@ -17,7 +17,9 @@ public:
 private:
     ValueHandler comparison();
     ValueHandler arithmetic();
+    ValueHandler pointerArithmetic(llvm::Value* lhsValue, llvm::Value* rhsValue);
     ValueHandler logical();
+    ValueHandler shift();
 };
 
 } // namespace lbc::Gen
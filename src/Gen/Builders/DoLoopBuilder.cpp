@@ -39,9 +39,11 @@ void DoLoopBuilder::build() {
 
     // body
     m_gen.switchBlock(m_bodyBlock);
-    m_gen.getControlStack().push(ControlFlowStatement::Do, { m_continueBlock, m_exitBlock });
+    auto depth = m_gen.getLifetimeDepth();
+    m_gen.getControlStack().push(ControlFlowStatement::Do, { m_continueBlock, m_exitBlock, depth });
     m_gen.visit(*m_ast.stmt);
     m_gen.getControlStack().pop();
+    m_gen.endLifetimes(depth);
 
     // post makeCondition
     switch (m_ast.condition) {
@@ -19,9 +19,34 @@ ForStmtBuilder::ForStmtBuilder(CodeGen& codeGen, AstForStmt& ast)
         return;
     }
 
-    createBlocks();
+    m_exitBlock = llvm::BasicBlock::Create(m_llvmContext, "for.end");
     declareVars();
     checkDirection();
+
+    switch (m_direction) {
+    case AstForStmt::Direction::Unknown:
+        // counted loop enters through the block computing the trip count
+        m_counted = m_type->isIntegral();
+        if (m_counted) {
+            m_incrLoop = m_decrLoop = {
+                llvm::BasicBlock::Create(m_llvmContext, "for.count"),
+                llvm::BasicBlock::Create(m_llvmContext, "for.body"),
+                llvm::BasicBlock::Create(m_llvmContext, "for.iter")
+            };
+        } else {
+            m_incrLoop = m_decrLoop = createLoop("for");
+        }
+        break;
+    case AstForStmt::Direction::Skip:
+        break;
+    case AstForStmt::Direction::Increment:
+        m_incrLoop = createLoop("for");
+        break;
+    case AstForStmt::Direction::Decrement:
+        m_decrLoop = createLoop("for");
+        break;
+    }
+
     configureStep();
     build();
 }
@@ -51,11 +76,35 @@ void ForStmtBuilder::checkDirection() {
     }
 }
 
-void ForStmtBuilder::createBlocks() {
-    m_condBlock = llvm::BasicBlock::Create(m_llvmContext, "for.cond");
-    m_bodyBlock = llvm::BasicBlock::Create(m_llvmContext, "for.body");
-    m_iterBlock = llvm::BasicBlock::Create(m_llvmContext, "for.iter");
-    m_exitBlock = llvm::BasicBlock::Create(m_llvmContext, "for.end");
+ForStmtBuilder::Loop ForStmtBuilder::createLoop(StringRef prefix) {
+    return {
+        llvm::BasicBlock::Create(m_llvmContext, prefix + ".cond"),
+        llvm::BasicBlock::Create(m_llvmContext, prefix + ".body"),
+        llvm::BasicBlock::Create(m_llvmContext, prefix + ".iter")
+    };
+}
+
+llvm::BasicBlock* ForStmtBuilder::getEntry(bool incr) const noexcept {
+    return incr ? m_incrLoop.cond : m_decrLoop.cond;
+}
+
+/**
+ * Branch to the loop matching the direction
+ */
+void ForStmtBuilder::enterLoop() {
+    switch (m_direction) {
+    case AstForStmt::Direction::Unknown:
+        m_builder.CreateBr(getEntry(true));
+        break;
+    case AstForStmt::Direction::Skip:
+        break;
+    case AstForStmt::Direction::Increment:
+        m_builder.CreateBr(getEntry(true));
+        break;
+    case AstForStmt::Direction::Decrement:
+        m_builder.CreateBr(getEntry(false));
+        break;
+    }
 }
 
 void ForStmtBuilder::configureStep() {
@@ -70,6 +119,7 @@ void ForStmtBuilder::configureStep() {
             llvm_unreachable("Unknown type");
         }
         m_step = ValueHandler{ &m_gen, stepVal };
+        enterLoop();
         return;
     }
 
@@ -96,6 +146,7 @@ void ForStmtBuilder::configureStep() {
             llvm_unreachable("Unkown type");
         }
         m_step = ValueHandler{ &m_gen, stepVal };
+        enterLoop();
         return;
     }
 
@@ -121,13 +172,13 @@ void ForStmtBuilder::configureStep() {
         m_builder.CreateCondBr(isStepNeg, negateBlock, m_exitBlock);
 
         m_gen.switchBlock(isIncrBlock);
-        m_builder.CreateCondBr(isStepNeg, m_exitBlock, m_condBlock);
+        m_builder.CreateCondBr(isStepNeg, m_exitBlock, getEntry(true));
         break;
     }
     case AstForStmt::Direction::Skip:
         break;
     case AstForStmt::Direction::Increment:
-        m_builder.CreateCondBr(isStepNeg, m_exitBlock, m_condBlock);
+        m_builder.CreateCondBr(isStepNeg, m_exitBlock, getEntry(true));
         break;
     case AstForStmt::Direction::Decrement:
         m_builder.CreateCondBr(isStepNeg, negateBlock, m_exitBlock);
@@ -135,50 +186,71 @@ void ForStmtBuilder::configureStep() {
     }
 
     m_gen.switchBlock(negateBlock);
-    stepValue = m_builder.CreateNeg(stepValue);
+    stepValue = m_gen.createNeg(stepValue, m_type);
     m_step.store(stepValue);
-    m_builder.CreateBr(m_condBlock);
+    m_builder.CreateBr(getEntry(false));
 }
 
 void ForStmtBuilder::build() {
-    llvm::BasicBlock* incrBlock = nullptr;
-    llvm::BasicBlock* decrBlock = nullptr;
+    switch (m_direction) {
+    case AstForStmt::Direction::Unknown:
+        if (m_counted) {
+            buildCountedLoop(m_incrLoop);
+        } else {
+            buildLoop(m_incrLoop, std::nullopt);
+        }
+        break;
+    case AstForStmt::Direction::Skip:
+        break;
+    case AstForStmt::Direction::Increment:
+        buildLoop(m_incrLoop, true);
+        break;
+    case AstForStmt::Direction::Decrement:
+        buildLoop(m_decrLoop, false);
+        break;
+    }
+
+    // End
+    m_gen.switchBlock(m_exitBlock);
+}
+
+/**
+ * Emit condition, body and iteration of the loop. Without a known
+ * incr the direction is checked on every iteration.
+ */
+void ForStmtBuilder::buildLoop(const Loop& loop, std::optional<bool> incr) {
+    llvm::BasicBlock* incrBlock = loop.cond;
+    llvm::BasicBlock* decrBlock = loop.cond;
 
     // Condition
-    m_gen.switchBlock(m_condBlock);
-    switch (m_direction) {
-    case AstForStmt::Direction::Unknown: {
+    m_gen.switchBlock(loop.cond);
+    if (incr) {
+        makeCondition(*incr, loop);
+    } else {
         incrBlock = llvm::BasicBlock::Create(m_llvmContext, "for.cond.incr");
         decrBlock = llvm::BasicBlock::Create(m_llvmContext, "for.cond.decr");
         m_builder.CreateCondBr(m_isDecr, decrBlock, incrBlock);
 
         m_gen.switchBlock(incrBlock);
-        makeCondition(true);
+        makeCondition(true, loop);
 
         m_gen.switchBlock(decrBlock);
-        makeCondition(false);
-        break;
-    }
-    case AstForStmt::Direction::Skip:
-        break;
-    case AstForStmt::Direction::Increment:
-        makeCondition(true);
-        break;
-    case AstForStmt::Direction::Decrement:
-        makeCondition(false);
-        break;
+        makeCondition(false, loop);
     }
 
     // Body
-    m_gen.switchBlock(m_bodyBlock);
-    m_gen.getControlStack().push(ControlFlowStatement::For, { m_iterBlock, m_exitBlock });
+    m_gen.switchBlock(loop.body);
+    auto depth = m_gen.getLifetimeDepth();
+    m_gen.getControlStack().push(ControlFlowStatement::For, { loop.iter, m_exitBlock, depth });
     m_gen.visit(*m_ast.stmt);
     m_gen.getControlStack().pop();
+    m_gen.endLifetimes(depth);
 
     // Iteration
-    m_gen.switchBlock(m_iterBlock);
-    switch (m_direction) {
-    case AstForStmt::Direction::Unknown: {
+    m_gen.switchBlock(loop.iter);
+    if (incr) {
+        makeIteration(*incr, loop.cond);
+    } else {
         auto* iterIncrBlock = llvm::BasicBlock::Create(m_llvmContext, "for.iter.incr");
         auto* iterDecrBlock = llvm::BasicBlock::Create(m_llvmContext, "for.iter.decr");
         m_builder.CreateCondBr(m_isDecr, iterDecrBlock, iterIncrBlock);
@@ -188,23 +260,62 @@ void ForStmtBuilder::build() {
 
         m_gen.switchBlock(iterDecrBlock);
         makeIteration(false, decrBlock);
-        break;
     }
-    case AstForStmt::Direction::Skip:
-        break;
-    case AstForStmt::Direction::Increment:
-        makeIteration(true, m_condBlock);
-        break;
-    case AstForStmt::Direction::Decrement:
-        makeIteration(false, m_condBlock);
-        break;
+}
+
+/**
+ * Emit loop whose trip count is computed once in the preheader. Entering
+ * in the direction of the limit guarantees at least one iteration, so
+ * the body runs first and the latch counts the remaining steps down.
+ */
+void ForStmtBuilder::buildCountedLoop(const Loop& loop) {
+    // Trip count
+    m_gen.switchBlock(loop.cond);
+    auto* stepValue = m_step.load();
+    auto* zero = llvm::Constant::getNullValue(m_llvmType);
+    if (!isa<llvm::Constant>(stepValue)) {
+        // zero step never reaches the limit
+        auto* isStepZero = m_builder.CreateICmpEQ(stepValue, zero, "for.isStepZero");
+        auto* countBlock = llvm::BasicBlock::Create(m_llvmContext, "for.count.step");
+        m_builder.CreateCondBr(isStepZero, m_exitBlock, countBlock);
+        m_gen.switchBlock(countBlock);
     }
 
-    // End
-    m_gen.switchBlock(m_exitBlock);
+    auto* iterValue = m_iterator.load();
+    auto* limitValue = m_limit.load();
+    auto* distance = m_builder.CreateSelect(
+        m_isDecr,
+        m_builder.CreateSub(iterValue, limitValue),
+        m_builder.CreateSub(limitValue, iterValue),
+        "for.distance");
+    auto* counter = m_gen.createAlloca(m_llvmType, "for.counter");
+    m_builder.CreateStore(m_builder.CreateUDiv(distance, stepValue, "for.steps"), counter);
+
+    // range is never left, so stepping cannot overflow
+    auto* signedStep = m_builder.CreateSelect(
+        m_isDecr,
+        m_builder.CreateNeg(stepValue),
+        stepValue,
+        "for.signedStep");
+
+    // Body
+    m_gen.switchBlock(loop.body);
+    auto depth = m_gen.getLifetimeDepth();
+    m_gen.getControlStack().push(ControlFlowStatement::For, { loop.iter, m_exitBlock, depth });
+    m_gen.visit(*m_ast.stmt);
+    m_gen.getControlStack().pop();
+    m_gen.endLifetimes(depth);
+
+    // Iteration
+    m_gen.switchBlock(loop.iter);
+    auto* remaining = m_builder.CreateLoad(m_llvmType, counter);
+    auto* isDone = m_builder.CreateICmpEQ(remaining, zero, "for.isDone");
+    m_builder.CreateStore(m_builder.CreateSub(remaining, llvm::ConstantInt::get(m_llvmType, 1)), counter);
+    m_iterator.store(m_builder.CreateAdd(m_iterator.load(), signedStep));
+    m_builder.CreateCondBr(isDone, m_exitBlock, loop.body);
 }
 
-void ForStmtBuilder::makeCondition(bool incr) {
+void ForStmtBuilder::makeCondition(bool incr, const Loop& loop) {
     auto lessOrEqualPred = getCmpPred(m_type, TokenKind::LessOrEqual);
     auto* iterValue = m_iterator.load();
     auto* limitValue = m_limit.load();
@@ -212,15 +323,14 @@ void ForStmtBuilder::makeCondition(bool incr) {
         ? m_builder.CreateCmp(lessOrEqualPred, iterValue, limitValue, "for.incrCond")
         : m_builder.CreateCmp(lessOrEqualPred, limitValue, iterValue, "for.decrCond");
 
-    m_builder.CreateCondBr(cmp, m_bodyBlock, m_exitBlock);
+    m_builder.CreateCondBr(cmp, loop.body, m_exitBlock);
 }
 
 void ForStmtBuilder::makeIteration(bool incr, llvm::BasicBlock* branch) {
     auto* stepValue = m_step.load();
     auto* iterValue = m_iterator.load();
-    auto* result = incr
-        ? m_builder.CreateAdd(iterValue, stepValue)
-        : m_builder.CreateSub(iterValue, stepValue);
+    auto op = getBinOpPred(m_type, incr ? TokenKind::Plus : TokenKind::Minus);
+    auto* result = m_gen.createBinOp(op, iterValue, stepValue, m_type);
     m_iterator.store(result);
     m_builder.CreateBr(branch);
 }
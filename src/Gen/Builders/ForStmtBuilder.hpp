@@ -9,29 +9,45 @@
 
 namespace lbc::Gen {
 
+/**
+ * Build FOR loop. When direction of an integer loop is only known at
+ * runtime, its trip count is computed once before entering and the
+ * loop counts it down. Floating point loops check direction on every
+ * iteration instead.
+ */
 class ForStmtBuilder final : Builder<AstForStmt> {
 public:
     ForStmtBuilder(CodeGen& codeGen, AstForStmt& ast);
 
 private:
+    struct Loop final {
+        llvm::BasicBlock* cond{};
+        llvm::BasicBlock* body{};
+        llvm::BasicBlock* iter{};
+    };
+
     void declareVars();
     void build();
-    void createBlocks();
+    [[nodiscard]] Loop createLoop(StringRef prefix);
     void configureStep();
     void checkDirection();
+    void enterLoop();
+    [[nodiscard]] llvm::BasicBlock* getEntry(bool incr) const noexcept;
 
-    void makeCondition(bool incr);
+    void buildLoop(const Loop& loop, std::optional<bool> incr);
+    void buildCountedLoop(const Loop& loop);
+    void makeCondition(bool incr, const Loop& loop);
     void makeIteration(bool incr, llvm::BasicBlock* branch);
 
     const AstForStmt::Direction m_direction;
+    bool m_counted = false;
 
     const TypeRoot* m_type = nullptr;
     llvm::Type* m_llvmType = nullptr;
     llvm::Value* m_isDecr = nullptr;
 
-    llvm::BasicBlock* m_condBlock{};
-    llvm::BasicBlock* m_bodyBlock{};
-    llvm::BasicBlock* m_iterBlock{};
+    Loop m_incrLoop{};
+    Loop m_decrLoop{};
     llvm::BasicBlock* m_exitBlock{};
 
     ValueHandler m_iterator{};
@@ -11,14 +11,21 @@ IfStmtBuilder::IfStmtBuilder(CodeGen& gen, AstIfStmt& ast)
     build();
 }
 
+/**
+ * Slots declared in a block header stay live in all following blocks,
+ * but only paths through that header start them. Each path ends the
+ * header slots it started before branching to if.end
+ */
 void IfStmtBuilder::build() {
     auto* func = m_builder.GetInsertBlock()->getParent();
     auto* endBlock = llvm::BasicBlock::Create(m_llvmContext, "if.end", func);
+    const auto headerDepth = m_gen.getLifetimeDepth();
 
     const auto count = m_ast.blocks.size();
     for (size_t idx = 0; idx < count; idx++) {
         const auto& block = m_ast.blocks[idx];
-        llvm::BasicBlock* elseBlock = nullptr;
+        const bool isLast = idx == count - 1;
+        llvm::BasicBlock* elseBlock = endBlock;
 
         for (const auto& decl : block.decls) {
             m_gen.visit(*decl);
@@ -28,21 +35,33 @@ void IfStmtBuilder::build() {
             auto* condition = m_gen.visit(*block.expr).load();
 
             auto* thenBlock = llvm::BasicBlock::Create(m_llvmContext, "if.then", func);
-            if (idx == count - 1) {
-                elseBlock = endBlock;
-            } else {
+            if (!isLast || m_gen.getLifetimeDepth() > headerDepth) {
                 elseBlock = llvm::BasicBlock::Create(m_llvmContext, "if.else", func);
             }
             m_builder.CreateCondBr(condition, thenBlock, elseBlock);
 
             m_gen.switchBlock(thenBlock);
-        } else {
-            elseBlock = endBlock;
         }
 
+        auto depth = m_gen.getLifetimeDepth();
         m_gen.visit(*block.stmt);
+        m_gen.endLifetimes(depth);
+        m_gen.endLifetimes(headerDepth, false);
         m_gen.terminateBlock(endBlock);
 
+        if (elseBlock == endBlock) {
+            break;
+        }
         m_gen.switchBlock(elseBlock);
+
+        // no condition matched
+        if (isLast) {
+            m_gen.endLifetimes(headerDepth, false);
+            m_gen.terminateBlock(endBlock);
+        }
     }
+
+    // every path is terminated, so this only forgets the header slots
+    m_gen.endLifetimes(headerDepth);
+    m_gen.switchBlock(endBlock);
 }
@@ -0,0 +1,88 @@
+//
+// Created by agent on 18/10/2026.
+//
+#include "IntrinsicBuilder.hpp"
+#include "Type/Type.hpp"
+using namespace lbc;
+using namespace Gen;
+
+ValueHandler IntrinsicBuilder::build() {
+    std::vector<llvm::Value*> args;
+    args.reserve(m_ast.args->exprs.size());
+    for (auto* arg : m_ast.args->exprs) {
+        args.emplace_back(m_gen.visit(*arg).load());
+    }
+    auto* value = args[0];
+    auto* type = value->getType();
+    const auto* scalar = m_ast.args->exprs[0]->type->getScalarType();
+
+    switch (m_ast.intrinsic) {
+    case IntrinsicKind::Sqr:
+        return { &m_gen, m_builder.CreateUnaryIntrinsic(llvm::Intrinsic::sqrt, value) };
+    case IntrinsicKind::Floor:
+        return { &m_gen, m_builder.CreateUnaryIntrinsic(llvm::Intrinsic::floor, value) };
+    case IntrinsicKind::Ceil:
+        return { &m_gen, m_builder.CreateUnaryIntrinsic(llvm::Intrinsic::ceil, value) };
+    case IntrinsicKind::Fma:
+        return { &m_gen, m_builder.CreateIntrinsic(llvm::Intrinsic::fma, { type }, args) };
+    case IntrinsicKind::Abs:
+        if (scalar->isFloatingPoint()) {
+            return { &m_gen, m_builder.CreateUnaryIntrinsic(llvm::Intrinsic::fabs, value) };
+        }
+        if (scalar->isSignedIntegral()) {
+            // abs of the minimum value wraps
+            return { &m_gen, m_builder.CreateBinaryIntrinsic(llvm::Intrinsic::abs, value, m_builder.getFalse()) };
+        }
+        return { &m_gen, value };
+    case IntrinsicKind::Min:
+    case IntrinsicKind::Max:
+        return { &m_gen, minMax(args[0], args[1]) };
+    case IntrinsicKind::PopCount:
+        return { &m_gen, m_builder.CreateUnaryIntrinsic(llvm::Intrinsic::ctpop, value) };
+    case IntrinsicKind::Clz:
+        return { &m_gen, m_builder.CreateBinaryIntrinsic(llvm::Intrinsic::ctlz, value, m_builder.getFalse()) };
+    case IntrinsicKind::Ctz:
+        return { &m_gen, m_builder.CreateBinaryIntrinsic(llvm::Intrinsic::cttz, value, m_builder.getFalse()) };
+    case IntrinsicKind::BSwap:
+        // single byte has nothing to swap
+        if (type->getScalarSizeInBits() == 8) {
+            return { &m_gen, value };
+        }
+        return { &m_gen, m_builder.CreateUnaryIntrinsic(llvm::Intrinsic::bswap, value) };
+    case IntrinsicKind::Prefetch:
+        return { &m_gen, prefetch(value) };
+    }
+    llvm_unreachable("Unknown intrinsic");
+}
+
+/**
+ * Floating point MIN / MAX return the other operand when one is NaN
+ */
+llvm::Value* IntrinsicBuilder::minMax(llvm::Value* lhs, llvm::Value* rhs) {
+    const auto* scalar = m_ast.type->getScalarType();
+    const bool isMin = m_ast.intrinsic == IntrinsicKind::Min;
+    if (scalar->isFloatingPoint()) {
+        return isMin ? m_builder.CreateMinNum(lhs, rhs) : m_builder.CreateMaxNum(lhs, rhs);
+    }
+    llvm::Intrinsic::ID id = llvm::Intrinsic::not_intrinsic;
+    if (scalar->isSignedIntegral()) {
+        id = isMin ? llvm::Intrinsic::smin : llvm::Intrinsic::smax;
+    } else {
+        id = isMin ? llvm::Intrinsic::umin : llvm::Intrinsic::umax;
+    }
+    return m_builder.CreateBinaryIntrinsic(id, lhs, rhs);
+}
+
+/**
+ * Read prefetch into all cache levels
+ */
+llvm::Value* IntrinsicBuilder::prefetch(llvm::Value* pointer) {
+    auto* address = m_builder.CreatePointerCast(pointer, m_builder.getInt8PtrTy());
+    llvm::Value* args[] = {
+        address,
+        m_builder.getInt32(0), // read
+        m_builder.getInt32(3), // high locality
+        m_builder.getInt32(1)  // data cache
+    };
+    return m_builder.CreateIntrinsic(llvm::Intrinsic::prefetch, { address->getType() }, args);
+}
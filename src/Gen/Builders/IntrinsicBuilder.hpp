@@ -0,0 +1,22 @@
+//
+// Created by agent on 18/10/2026.
+//
+#pragma once
+#include "Ast/Ast.hpp"
+#include "Builder.hpp"
+#include "Gen/CodeGen.hpp"
+#include "Gen/ValueHandler.hpp"
+
+namespace lbc::Gen {
+
+class IntrinsicBuilder final : Builder<AstIntrinsicExpr> {
+public:
+    using Builder::Builder;
+    ValueHandler build();
+
+private:
+    llvm::Value* minMax(llvm::Value* lhs, llvm::Value* rhs);
+    llvm::Value* prefetch(llvm::Value* pointer);
+};
+
+} // namespace lbc::Gen
@@ -6,13 +6,18 @@
 #include "Builders/DoLoopBuilder.hpp"
 #include "Builders/ForStmtBuilder.hpp"
 #include "Builders/IfStmtBuilder.hpp"
+#include "Builders/IntrinsicBuilder.hpp"
+#include "Driver/CompileOptions.hpp"
 #include "Driver/Context.hpp"
 #include "Helpers.hpp"
 #include "Type/Type.hpp"
 #include "ValueHandler.hpp"
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/Dominators.h>
 #include <llvm/IR/IRPrintingPasses.h>
+#include <llvm/IR/MDBuilder.h>
 #include <llvm/Transforms/Utils/ModuleUtils.h>
+#include <llvm/Transforms/Utils/PromoteMemToReg.h>
 using namespace lbc;
 using namespace Gen;
 
@@ -22,6 +27,7 @@ CodeGen::CodeGen(Context& context)
   m_builder{ m_llvmContext },
   m_constantTrue{ m_builder.getTrue() },
   m_constantFalse{ m_builder.getFalse() } {
+    m_builder.setFastMathFlags(context.getOptions().getFastMathFlags());
 }
 
 bool CodeGen::validate() const noexcept {
@@ -51,6 +57,119 @@ void CodeGen::switchBlock(llvm::BasicBlock* block) {
     m_builder.SetInsertPoint(block);
 }
 
+llvm::AllocaInst* CodeGen::createAlloca(llvm::Type* type, const Twine& name, llvm::MaybeAlign alignment) {
+    llvm::AllocaInst* alloca = nullptr;
+    if (auto* func = m_builder.GetInsertBlock()->getParent()) {
+        // allocate once per call, not every time a loop body runs
+        auto& entry = func->getEntryBlock();
+        llvm::IRBuilder<> builder{ &entry, entry.getFirstInsertionPt() };
+        alloca = builder.CreateAlloca(type, nullptr, name);
+    } else {
+        alloca = m_builder.CreateAlloca(type, nullptr, name);
+    }
+    if (alignment) {
+        alloca->setAlignment(std::max(alloca->getAlign(), *alignment));
+    }
+    return alloca;
+}
+
+llvm::MaybeAlign CodeGen::getAlignment(const Symbol& symbol) {
+    uint64_t alignment = symbol.getAlignment();
+    if (symbol.getParent() == nullptr && !symbol.type()->isFunction()) {
+        alignment = std::max(alignment, symbol.type()->getAlignment(m_context));
+    }
+    if (alignment == 0) {
+        return {};
+    }
+    return llvm::Align(alignment);
+}
+
+void CodeGen::endLifetimes(size_t depth, bool forget) {
+    if (m_builder.GetInsertBlock()->getTerminator() == nullptr) {
+        const auto& layout = m_module->getDataLayout();
+        for (auto index = m_lifetimes.size(); index > depth; index--) {
+            const auto& local = m_lifetimes[index - 1];
+            if (local.ownsBuffer) {
+                freeArray(local.slot);
+            }
+            if (local.hasLifetime) {
+                auto size = layout.getTypeAllocSize(local.slot->getAllocatedType()).getFixedSize();
+                m_builder.CreateLifetimeEnd(local.slot, m_builder.getInt64(size));
+            }
+        }
+    }
+    if (forget) {
+        m_lifetimes.resize(std::min(depth, m_lifetimes.size()));
+    }
+}
+
+llvm::Value* CodeGen::createBinOp(llvm::Instruction::BinaryOps op, llvm::Value* lhs, llvm::Value* rhs, const TypeRoot* type) {
+    if (!type->getScalarType()->isSignedIntegral()) {
+        return m_builder.CreateBinOp(op, lhs, rhs);
+    }
+
+    switch (m_context.getOptions().getOverflowMode()) {
+    case CompileOptions::OverflowMode::Wrap:
+        return m_builder.CreateBinOp(op, lhs, rhs);
+    case CompileOptions::OverflowMode::Undefined:
+        switch (op) {
+        case llvm::Instruction::Add:
+            return m_builder.CreateNSWAdd(lhs, rhs);
+        case llvm::Instruction::Sub:
+            return m_builder.CreateNSWSub(lhs, rhs);
+        case llvm::Instruction::Mul:
+            return m_builder.CreateNSWMul(lhs, rhs);
+        default:
+            return m_builder.CreateBinOp(op, lhs, rhs);
+        }
+    case CompileOptions::OverflowMode::Trap:
+        switch (op) {
+        case llvm::Instruction::Add:
+            return createCheckedBinOp(llvm::Intrinsic::sadd_with_overflow, lhs, rhs);
+        case llvm::Instruction::Sub:
+            return createCheckedBinOp(llvm::Intrinsic::ssub_with_overflow, lhs, rhs);
+        case llvm::Instruction::Mul:
+            return createCheckedBinOp(llvm::Intrinsic::smul_with_overflow, lhs, rhs);
+        default:
+            return m_builder.CreateBinOp(op, lhs, rhs);
+        }
+    }
+    llvm_unreachable("Unknown overflow mode");
+}
+
+llvm::Value* CodeGen::createNeg(llvm::Value* value, const TypeRoot* type) {
+    if (value->getType()->isFPOrFPVectorTy()) {
+        return m_builder.CreateFNeg(value);
+    }
+    auto* zero = llvm::ConstantInt::get(value->getType(), 0);
+    return createBinOp(llvm::Instruction::Sub, zero, value, type);
+}
+
+llvm::Value* CodeGen::createCheckedBinOp(llvm::Intrinsic::ID id, llvm::Value* lhs, llvm::Value* rhs) {
+    auto* func = m_builder.GetInsertBlock()->getParent();
+    auto* result = m_builder.CreateBinaryIntrinsic(id, lhs, rhs);
+    auto* overflow = m_builder.CreateExtractValue(result, 1, "overflow");
+    if (overflow->getType()->isVectorTy()) {
+        overflow = m_builder.CreateOrReduce(overflow);
+    }
+    auto* contBlock = llvm::BasicBlock::Create(m_llvmContext, "overflow.cont");
+    auto* weights = llvm::MDBuilder(m_llvmContext).createBranchWeights(1, (1U << 20U) - 1);
+    m_builder.CreateCondBr(overflow, getTrapBlock(func), contBlock, weights);
+    switchBlock(contBlock);
+    return m_builder.CreateExtractValue(result, 0);
+}
+
+llvm::BasicBlock* CodeGen::getTrapBlock(llvm::Function* func) {
+    auto& block = m_trapBlocks[func];
+    if (block == nullptr) {
+        block = llvm::BasicBlock::Create(m_llvmContext, "overflow.trap", func);
+        llvm::IRBuilder<> builder{ block };
+        builder.CreateIntrinsic(llvm::Intrinsic::trap, {}, {});
+        builder.CreateUnreachable();
+    }
+    return block;
+}
+
 void CodeGen::visit(AstModule& ast) {
     m_astRootModule = &ast;
     m_fileId = ast.fileId;
@@ -59,8 +178,9 @@ void CodeGen::visit(AstModule& ast) {
 
     m_module = make_unique<llvm::Module>(file, m_llvmContext);
     m_module->setTargetTriple(m_context.getTriple().str());
+    m_module->setDataLayout(m_context.getDataLayout());
 
-    declareFuncs(*ast.stmtList);
+    collectFuncs(*ast.stmtList);
 
     if (m_context.getTriple().isOSWindows()) {
         auto* chkstk = llvm::Function::Create(
@@ -71,6 +191,8 @@ void CodeGen::visit(AstModule& ast) {
         chkstk->setCallingConv(llvm::CallingConv::C);
         chkstk->setDSOLocal(true);
         chkstk->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Local);
+        chkstk->addFnAttr(llvm::Attribute::NoUnwind);
+        addTargetAttributes(chkstk);
         auto* block = llvm::BasicBlock::Create(m_llvmContext, "entry", chkstk);
         m_builder.SetInsertPoint(block);
         m_builder.CreateRetVoid();
@@ -94,6 +216,9 @@ void CodeGen::visit(AstModule& ast) {
         mainFn->setCallingConv(llvm::CallingConv::C);
         mainFn->setDSOLocal(true);
         mainFn->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Local);
+        mainFn->addFnAttr(llvm::Attribute::NoUnwind);
+        addTargetAttributes(mainFn);
+        addFastMathAttributes(mainFn, m_context.getOptions().getFastMathFlags());
         auto* block = llvm::BasicBlock::Create(m_llvmContext, "entry", mainFn);
         m_builder.SetInsertPoint(block);
     } else {
@@ -109,6 +234,7 @@ void CodeGen::visit(AstModule& ast) {
         auto* retValue = llvm::Constant::getNullValue(llvm::IntegerType::getInt32Ty(m_llvmContext));
         auto& lastBlock = mainFn->getBasicBlockList().back();
         llvm::ReturnInst::Create(m_llvmContext, retValue, &lastBlock);
+        promoteLocals(mainFn);
     }
 
     if (m_globalCtorFunc != nullptr) {
@@ -116,9 +242,35 @@ void CodeGen::visit(AstModule& ast) {
         if (block->getTerminator() == nullptr) {
             llvm::ReturnInst::Create(m_llvmContext, nullptr, block);
         }
+        promoteLocals(m_globalCtorFunc);
     }
 }
 
+/**
+ * Locals, parameters and FOR iterators are emitted as stack slots.
+ * Once function is complete, rewrite slots whose address never escapes
+ * into SSA values and phis, so that even unoptimized code keeps them
+ * in registers and optimizer has less work to do.
+ */
+void CodeGen::promoteLocals(llvm::Function* func) {
+    std::vector<llvm::AllocaInst*> allocas;
+    for (auto& block : *func) {
+        for (auto& inst : block) {
+            if (auto* alloca = dyn_cast<llvm::AllocaInst>(&inst)) {
+                if (llvm::isAllocaPromotable(alloca)) {
+                    allocas.push_back(alloca);
+                }
+            }
+        }
+    }
+    if (allocas.empty()) {
+        return;
+    }
+
+    llvm::DominatorTree domTree{ *func };
+    llvm::PromoteMemToReg(allocas, domTree);
+}
+
 llvm::BasicBlock* CodeGen::getGlobalCtorBlock() {
     if (m_globalCtorFunc == nullptr) {
         m_globalCtorFunc = llvm::Function::Create(
@@ -126,6 +278,9 @@ llvm::BasicBlock* CodeGen::getGlobalCtorBlock() {
             llvm::Function::InternalLinkage,
             "__lbc_global_var_init",
             *m_module);
+        m_globalCtorFunc->addFnAttr(llvm::Attribute::NoUnwind);
+        addTargetAttributes(m_globalCtorFunc);
+        addFastMathAttributes(m_globalCtorFunc, m_context.getOptions().getFastMathFlags());
         if (m_context.getTriple().isOSBinFormatMachO()) {
             m_globalCtorFunc->setSection("__TEXT,__StaticInit,regular,pure_instructions");
         } else if (m_context.getTriple().isOSBinFormatELF()) {
@@ -189,6 +344,8 @@ void CodeGen::declareGlobalVar(AstVarDecl& ast) {
         if (auto* litExpr = dyn_cast<AstLiteralExpr>(ast.expr)) {
             auto rvalue = visit(*litExpr);
             constant = llvm::cast<llvm::Constant>(rvalue.load());
+        } else if (auto* arrayExpr = dyn_cast<AstArrayExpr>(ast.expr); arrayExpr != nullptr && arrayExpr->isConstant()) {
+            constant = llvm::cast<llvm::Constant>(visit(*arrayExpr).load());
         } else {
             generateStoreInCtror = true;
         }
@@ -197,13 +354,14 @@ void CodeGen::declareGlobalVar(AstVarDecl& ast) {
     if (constant == nullptr) {
         constant = llvm::Constant::getNullValue(exprType);
     }
-    llvm::Value* lvalue = new llvm::GlobalVariable(
+    auto* lvalue = new llvm::GlobalVariable(
         *m_module,
         exprType,
         false,
         sym->getLlvmLinkage(),
         constant,
         ast.symbol->identifier());
+    lvalue->setAlignment(getAlignment(*sym));
 
     if (generateStoreInCtror) {
         auto* block = m_builder.GetInsertBlock();
@@ -225,34 +383,91 @@ void CodeGen::declareLocalVar(AstVarDecl& ast) {
         rvalue = visit(*ast.expr);
     }
 
-    auto* lvalue = m_builder.CreateAlloca(exprType, nullptr, ast.symbol->identifier());
+    auto* lvalue = createAlloca(exprType, ast.symbol->identifier(), getAlignment(*ast.symbol));
+    const auto& layout = m_module->getDataLayout();
+    auto size = layout.getTypeAllocSize(exprType).getFixedSize();
+
+    // block scoped slot, let the stack space be reused outside of it.
+    // Dynamic array buffer is released at the end of the scope
+    bool hasLifetime = m_blockScopes > 0;
+    bool ownsBuffer = ast.symbol->type()->isDynamicArray();
+    if (hasLifetime) {
+        m_builder.CreateLifetimeStart(lvalue, m_builder.getInt64(size));
+    }
+    if (hasLifetime || ownsBuffer) {
+        m_lifetimes.push_back({ lvalue, hasLifetime, ownsBuffer });
+    }
+    if (ownsBuffer) {
+        m_builder.CreateStore(llvm::Constant::getNullValue(exprType), lvalue);
+    }
 
     if (rvalue.isValid()) {
-        m_builder.CreateStore(rvalue.load(), lvalue);
+        auto* value = rvalue.load();
+        if (isa<AstArrayExpr>(ast.expr) && isa<llvm::Constant>(value)) {
+            // copy constant arrays from read only data instead of
+            // storing elements one by one
+            auto* init = createConstantGlobal(llvm::cast<llvm::Constant>(value), ast.symbol->identifier() + ".init");
+            m_builder.CreateMemCpy(lvalue, lvalue->getAlign(), init, init->getAlign(), size);
+        } else {
+            m_builder.CreateStore(value, lvalue);
+        }
     }
 
     ast.symbol->setLlvmValue(lvalue);
 }
 
+void CodeGen::visit(AstConstDecl& ast) {
+    // uses of scalar constants are replaced with literals
+    if (!ast.symbol->type()->isArray()) {
+        return;
+    }
+    auto* value = llvm::cast<llvm::Constant>(visit(*ast.expr).load());
+    ast.symbol->setLlvmValue(createConstantGlobal(value, ast.symbol->identifier()));
+}
+
+/**
+ * Private unnamed constant ends up in read only data section
+ */
+llvm::GlobalVariable* CodeGen::createConstantGlobal(llvm::Constant* value, const Twine& name) {
+    auto* global = new llvm::GlobalVariable(
+        *m_module,
+        value->getType(),
+        true,
+        llvm::GlobalValue::PrivateLinkage,
+        value,
+        name);
+    global->setUnnamedAddr(llvm::GlobalValue::UnnamedAddr::Global);
+    global->setAlignment(m_module->getDataLayout().getPrefTypeAlign(value->getType()));
+    return global;
+}
+
 // Functions
 
 void CodeGen::visit(AstFuncDecl& /*ast*/) {
     // NOOP
 }
 
-void CodeGen::declareFuncs(AstStmtList& ast) {
+/**
+ * Record function declarations without emitting them. Declarations are
+ * created on first reference, so unused imports cost nothing in the module.
+ */
+void CodeGen::collectFuncs(AstStmtList& ast) {
     for (const auto& stmt : ast.stmts) {
         switch (stmt->kind) {
-        case AstKind::FuncDecl:
-            declareFunc(static_cast<AstFuncDecl&>(*stmt));
+        case AstKind::FuncDecl: {
+            auto& decl = static_cast<AstFuncDecl&>(*stmt);
+            m_funcDecls.try_emplace(decl.symbol, &decl);
             break;
-        case AstKind::FuncStmt:
-            declareFunc(*static_cast<AstFuncStmt&>(*stmt).decl);
+        }
+        case AstKind::FuncStmt: {
+            auto* decl = static_cast<AstFuncStmt&>(*stmt).decl;
+            m_funcDecls.try_emplace(decl->symbol, decl);
             break;
+        }
         case AstKind::Import: {
             auto& import = static_cast<AstImport&>(*stmt);
             if (import.module != nullptr) {
-                declareFuncs(*import.module->stmtList);
+                collectFuncs(*import.module->stmtList);
             }
             break;
         }
@@ -262,8 +477,14 @@ void CodeGen::declareFuncs(AstStmtList& ast) {
     }
 }
 
-void CodeGen::declareFunc(AstFuncDecl& ast) {
+llvm::Function* CodeGen::getOrDeclareFunc(AstFuncDecl& ast) {
     auto* sym = ast.symbol;
+    if (auto* fn = llvm::dyn_cast_or_null<llvm::Function>(sym->getLlvmValue())) {
+        if (fn->getParent() == m_module.get()) {
+            return fn;
+        }
+    }
+
     auto* fnTy = llvm::cast<llvm::FunctionType>(ast.symbol->type()->getLlvmType(m_context));
     auto* fn = llvm::Function::Create(
         fnTy,
@@ -273,6 +494,7 @@ void CodeGen::declareFunc(AstFuncDecl& ast) {
     fn->setCallingConv(llvm::CallingConv::C);
     fn->setDSOLocal(true);
     ast.symbol->setLlvmValue(fn);
+    addFuncAttributes(fn, ast);
 
     if (ast.params != nullptr) {
         auto* iter = fn->arg_begin();
@@ -282,6 +504,94 @@ void CodeGen::declareFunc(AstFuncDecl& ast) {
             iter++; // NOLINT
         }
     }
+    return fn;
+}
+
+/**
+ * Language has no exceptions, so nothing generated can unwind. Memory
+ * effects inferred by semantic analysis are dropped when overflow traps,
+ * otherwise optimizer could delete a call together with its trap.
+ */
+void CodeGen::addFuncAttributes(llvm::Function* fn, const AstFuncDecl& ast) {
+    if (const auto* attribs = ast.attributes) {
+        if (attribs->exists("INLINE")) {
+            fn->addFnAttr(llvm::Attribute::AlwaysInline);
+        } else if (attribs->exists("NOINLINE")) {
+            fn->addFnAttr(llvm::Attribute::NoInline);
+        }
+        if (attribs->exists("HOT")) {
+            fn->addFnAttr(llvm::Attribute::Hot);
+        } else if (attribs->exists("COLD")) {
+            fn->addFnAttr(llvm::Attribute::Cold);
+        }
+    }
+
+    if (!ast.hasImpl) {
+        return;
+    }
+    fn->addFnAttr(llvm::Attribute::NoUnwind);
+    addTargetAttributes(fn);
+    addFastMathAttributes(fn, getFastMathFlags(ast));
+    if (m_context.getOptions().getOverflowMode() == CompileOptions::OverflowMode::Trap) {
+        return;
+    }
+
+    const auto& effects = ast.symbol->getFuncEffects();
+    if (!effects.readsMemory && !effects.writesMemory) {
+        fn->addFnAttr(llvm::Attribute::ReadNone);
+    } else {
+        if (!effects.writesMemory) {
+            fn->addFnAttr(llvm::Attribute::ReadOnly);
+        }
+        if (effects.argMemOnly) {
+            fn->addFnAttr(llvm::Attribute::ArgMemOnly);
+        }
+    }
+    if (effects.willReturn) {
+        fn->addFnAttr(llvm::Attribute::WillReturn);
+    }
+}
+
+/**
+ * Optimizer picks vector width and instruction selection picks
+ * instructions by these, per function
+ */
+void CodeGen::addTargetAttributes(llvm::Function* fn) {
+    if (auto cpu = m_context.getTargetCpu(); !cpu.empty()) {
+        fn->addFnAttr("target-cpu", cpu);
+    }
+    if (auto features = m_context.getTargetFeatures(); !features.empty()) {
+        fn->addFnAttr("target-features", features);
+    }
+}
+
+llvm::FastMathFlags CodeGen::getFastMathFlags(const AstFuncDecl& ast) const {
+    if (ast.attributes != nullptr && ast.attributes->exists("FASTMATH")) {
+        return llvm::FastMathFlags::getFast();
+    }
+    return m_context.getOptions().getFastMathFlags();
+}
+
+/**
+ * Instructions carry their own fast-math flags, but code generator
+ * and some passes still query these function wide
+ */
+void CodeGen::addFastMathAttributes(llvm::Function* fn, llvm::FastMathFlags flags) {
+    if (flags.noNaNs()) {
+        fn->addFnAttr("no-nans-fp-math", "true");
+    }
+    if (flags.noInfs()) {
+        fn->addFnAttr("no-infs-fp-math", "true");
+    }
+    if (flags.noSignedZeros()) {
+        fn->addFnAttr("no-signed-zeros-fp-math", "true");
+    }
+    if (flags.approxFunc()) {
+        fn->addFnAttr("approx-func-fp-math", "true");
+    }
+    if (flags.isFast()) {
+        fn->addFnAttr("unsafe-fp-math", "true");
+    }
 }
 
 void CodeGen::visit(AstFuncParamDecl& /*ast*/) {
@@ -295,7 +605,16 @@ void CodeGen::visit(AstFuncStmt& ast) {
     RESTORE_ON_EXIT(m_declareAsGlobals);
     m_declareAsGlobals = false;
 
-    auto* func = llvm::cast<llvm::Function>(ast.decl->symbol->getLlvmValue());
+    RESTORE_ON_EXIT(m_funcLifetimeDepth);
+    m_funcLifetimeDepth = getLifetimeDepth();
+
+    RESTORE_ON_EXIT(m_flatten);
+    m_flatten = ast.decl->attributes != nullptr && ast.decl->attributes->exists("FLATTEN");
+
+    llvm::IRBuilderBase::FastMathFlagGuard fastMathGuard{ m_builder };
+    m_builder.setFastMathFlags(getFastMathFlags(*ast.decl));
+
+    auto* func = getOrDeclareFunc(*ast.decl);
 
     auto* current = m_builder.GetInsertBlock();
     auto* block = llvm::BasicBlock::Create(m_llvmContext, "", func);
@@ -305,15 +624,16 @@ void CodeGen::visit(AstFuncStmt& ast) {
         for (const auto& param : ast.decl->params->params) {
             auto* sym = param->symbol;
             auto* value = sym->getLlvmValue();
-            sym->setLlvmValue(m_builder.CreateAlloca(
+            sym->setLlvmValue(createAlloca(
                 sym->type()->getLlvmType(m_context),
-                nullptr,
-                sym->identifier() + ".addr"));
+                sym->identifier() + ".addr",
+                getAlignment(*sym)));
             m_builder.CreateStore(value, sym->getLlvmValue());
         }
     }
 
     visit(*ast.stmtList);
+    endLifetimes(m_funcLifetimeDepth);
 
     block = m_builder.GetInsertBlock();
     if (block->getTerminator() == nullptr) {
@@ -324,14 +644,17 @@ void CodeGen::visit(AstFuncStmt& ast) {
         m_builder.CreateRetVoid();
     }
 
+    promoteLocals(func);
     m_builder.SetInsertPoint(current);
 }
 
 void CodeGen::visit(AstReturnStmt& ast) {
     if (ast.expr != nullptr) {
-        auto value = visit(*ast.expr);
-        m_builder.CreateRet(value.load());
+        auto* value = visit(*ast.expr).load();
+        freeArrays(m_funcLifetimeDepth);
+        m_builder.CreateRet(value);
     } else {
+        freeArrays(m_funcLifetimeDepth);
         auto* func = m_builder.GetInsertBlock()->getParent();
         auto* retTy = func->getReturnType();
 
@@ -359,19 +682,31 @@ void CodeGen::visit(AstTypeDecl& /*ast*/) {
 void CodeGen::visit(AstIfStmt& ast) {
     RESTORE_ON_EXIT(m_declareAsGlobals);
     m_declareAsGlobals = false;
+    m_blockScopes++;
+    auto depth = getLifetimeDepth();
     Gen::IfStmtBuilder(*this, ast);
+    endLifetimes(depth);
+    m_blockScopes--;
 }
 
 void CodeGen::visit(AstForStmt& ast) {
     RESTORE_ON_EXIT(m_declareAsGlobals);
     m_declareAsGlobals = false;
+    m_blockScopes++;
+    auto depth = getLifetimeDepth();
     Gen::ForStmtBuilder(*this, ast);
+    endLifetimes(depth);
+    m_blockScopes--;
 }
 
 void CodeGen::visit(AstDoLoopStmt& ast) {
     RESTORE_ON_EXIT(m_declareAsGlobals);
     m_declareAsGlobals = false;
+    m_blockScopes++;
+    auto depth = getLifetimeDepth();
     Gen::DoLoopBuilder(*this, ast);
+    endLifetimes(depth);
+    m_blockScopes--;
 }
 
 void CodeGen::visit(AstContinuationStmt& ast) {
@@ -380,6 +715,9 @@ void CodeGen::visit(AstContinuationStmt& ast) {
         fatalError("control statement not found");
     }
 
+    // leaving loop body, slots declared in it are dead
+    endLifetimes(target->second.lifetimeDepth, false);
+
     switch (ast.action) {
     case AstContinuationStmt::Action::Continue:
         m_builder.CreateBr(target->second.continueBlock);
@@ -392,6 +730,147 @@ void CodeGen::visit(AstContinuationStmt& ast) {
     addBlock();
 }
 
+//------------------------------------------------------------------
+// Dynamic arrays
+//------------------------------------------------------------------
+
+/**
+ * REDIM sets the length. Capacity only grows, so shrinking and growing
+ * again reuses the buffer. Elements past the preserved ones are zeroed
+ */
+void CodeGen::visit(AstRedimStmt& ast) {
+    const auto* type = llvm::cast<TypeDynamicArray>(ast.expr->type);
+    auto* sizeTy = m_builder.getInt64Ty();
+
+    auto* upper = visit(*ast.upper).load();
+    upper = m_builder.CreateIntCast(upper, sizeTy, ast.upper->type->isSignedIntegral());
+    // upper bound below -1 leaves the array empty
+    auto* length = m_builder.CreateBinaryIntrinsic(
+        llvm::Intrinsic::smax,
+        m_builder.CreateAdd(upper, m_builder.getInt64(1)),
+        m_builder.getInt64(0));
+
+    auto target = visit(*ast.expr);
+    auto* array = target.load();
+    llvm::Value* keep = m_builder.getInt64(0);
+    if (ast.preserve) {
+        auto* current = m_builder.CreateExtractValue(array, 1);
+        keep = m_builder.CreateBinaryIntrinsic(llvm::Intrinsic::umin, current, length);
+    }
+    array = reserveArray(array, keep, length, type, false);
+
+    auto* elementTy = type->getElement()->getLlvmType(m_context);
+    const auto& layout = m_module->getDataLayout();
+    auto size = layout.getTypeAllocSize(elementTy).getFixedSize();
+    auto* data = m_builder.CreateExtractValue(array, 0);
+    auto* tail = m_builder.CreateInBoundsGEP(elementTy, data, keep);
+    auto* bytes = m_builder.CreateNUWMul(m_builder.CreateNUWSub(length, keep), m_builder.getInt64(size));
+    m_builder.CreateMemSet(tail, m_builder.getInt8(0), bytes, layout.getABITypeAlign(elementTy));
+
+    target.store(m_builder.CreateInsertValue(array, length, 1));
+}
+
+/**
+ * Append is inlined, runtime is called only when capacity is exhausted
+ */
+void CodeGen::visit(AstAppendStmt& ast) {
+    const auto* type = llvm::cast<TypeDynamicArray>(ast.expr->type);
+    auto* value = visit(*ast.value).load();
+
+    auto target = visit(*ast.expr);
+    auto* array = target.load();
+    auto* length = m_builder.CreateExtractValue(array, 1);
+    auto* required = m_builder.CreateNUWAdd(length, m_builder.getInt64(1));
+    array = reserveArray(array, length, required, type, true);
+
+    auto* elementTy = type->getElement()->getLlvmType(m_context);
+    auto* data = m_builder.CreateExtractValue(array, 0);
+    m_builder.CreateStore(value, m_builder.CreateInBoundsGEP(elementTy, data, length));
+
+    target.store(m_builder.CreateInsertValue(array, required, 1));
+}
+
+/**
+ * Ensure array has capacity for required elements, keeping the first
+ * `keep` of them. Growing calls the runtime, which at least doubles
+ * the capacity. Returns the array with updated data and capacity
+ */
+llvm::Value* CodeGen::reserveArray(llvm::Value* array, llvm::Value* keep, llvm::Value* required, const TypeDynamicArray* type, bool growUnlikely) {
+    auto* func = m_builder.GetInsertBlock()->getParent();
+    auto* block = m_builder.GetInsertBlock();
+    auto* capacity = m_builder.CreateExtractValue(array, 2);
+    auto* fits = m_builder.CreateICmpULE(required, capacity);
+
+    auto* growBlock = llvm::BasicBlock::Create(m_llvmContext, "array.grow", func);
+    auto* contBlock = llvm::BasicBlock::Create(m_llvmContext, "array.cont");
+    llvm::MDNode* weights = nullptr;
+    if (growUnlikely) {
+        weights = llvm::MDBuilder(m_llvmContext).createBranchWeights((1U << 20U) - 1, 1);
+    }
+    m_builder.CreateCondBr(fits, contBlock, growBlock, weights);
+
+    m_builder.SetInsertPoint(growBlock);
+    auto* elementTy = type->getElement()->getLlvmType(m_context);
+    auto size = m_module->getDataLayout().getTypeAllocSize(elementTy).getFixedSize();
+    auto* data = m_builder.CreateExtractValue(array, 0);
+    auto* buffer = m_builder.CreateCall(
+        getArrayReserveFunc(),
+        { m_builder.CreatePointerCast(data, m_builder.getInt8PtrTy()),
+            keep,
+            capacity,
+            required,
+            m_builder.getInt64(size) });
+    auto* newData = m_builder.CreatePointerCast(m_builder.CreateExtractValue(buffer, 0), data->getType());
+    auto* grown = m_builder.CreateInsertValue(array, newData, 0);
+    grown = m_builder.CreateInsertValue(grown, m_builder.CreateExtractValue(buffer, 1), 2);
+
+    switchBlock(contBlock);
+    auto* phi = m_builder.CreatePHI(array->getType(), 2);
+    phi->addIncoming(array, block);
+    phi->addIncoming(grown, growBlock);
+    return phi;
+}
+
+/**
+ * Release dynamic arrays above the depth before leaving the function
+ */
+void CodeGen::freeArrays(size_t depth) {
+    for (auto index = m_lifetimes.size(); index > depth; index--) {
+        const auto& local = m_lifetimes[index - 1];
+        if (local.ownsBuffer) {
+            freeArray(local.slot);
+        }
+    }
+}
+
+void CodeGen::freeArray(llvm::AllocaInst* slot) {
+    auto* array = m_builder.CreateLoad(slot->getAllocatedType(), slot);
+    auto* data = m_builder.CreateExtractValue(array, 0);
+    m_builder.CreateCall(getArrayFreeFunc(), { m_builder.CreatePointerCast(data, m_builder.getInt8PtrTy()) });
+}
+
+/**
+ * Runtime library functions, see runtime/Array.cpp
+ */
+llvm::FunctionCallee CodeGen::getArrayReserveFunc() {
+    auto* ptrTy = m_builder.getInt8PtrTy();
+    auto* sizeTy = m_builder.getInt64Ty();
+    auto* bufferTy = llvm::StructType::get(m_llvmContext, { ptrTy, sizeTy });
+    auto callee = m_module->getOrInsertFunction(
+        "__lbc_array_reserve",
+        llvm::FunctionType::get(bufferTy, { ptrTy, sizeTy, sizeTy, sizeTy, sizeTy }, false));
+    llvm::cast<llvm::Function>(callee.getCallee())->addFnAttr(llvm::Attribute::NoUnwind);
+    return callee;
+}
+
+llvm::FunctionCallee CodeGen::getArrayFreeFunc() {
+    auto callee = m_module->getOrInsertFunction(
+        "__lbc_array_free",
+        llvm::FunctionType::get(m_builder.getVoidTy(), { m_builder.getInt8PtrTy() }, false));
+    llvm::cast<llvm::Function>(callee.getCallee())->addFnAttr(llvm::Attribute::NoUnwind);
+    return callee;
+}
+
 //------------------------------------------------------------------
 // Attributes
 //------------------------------------------------------------------
@@ -417,6 +896,11 @@ void CodeGen::visit(AstTypeExpr& /*ast*/) {
 //------------------------------------------------------------------
 
 ValueHandler CodeGen::visit(AstIdentExpr& ast) {
+    if (ast.symbol->getFlags().callable) {
+        if (auto iter = m_funcDecls.find(ast.symbol); iter != m_funcDecls.end()) {
+            getOrDeclareFunc(*iter->second);
+        }
+    }
     return { this, ast };
 }
 
@@ -434,6 +918,99 @@ ValueHandler CodeGen::visit(AstAddressOf& ast) {
     return { this, value.getAddress() };
 }
 
+/**
+ * Element address of zero based index, as `inbounds` lets optimizer
+ * assume index stays within the array. Dynamic array elements are
+ * addressed directly from the data pointer without bounds checks.
+ */
+ValueHandler CodeGen::visit(AstIndexExpr& ast) {
+    auto* index = visit(*ast.index).load();
+    auto* indexTy = m_module->getDataLayout().getIntPtrType(m_llvmContext);
+    index = m_builder.CreateIntCast(index, indexTy, ast.index->type->isSignedIntegral());
+
+    if (const auto* dynamic = dyn_cast<TypeDynamicArray>(ast.expr->type)) {
+        auto* data = m_builder.CreateExtractValue(visit(*ast.expr).load(), 0);
+        auto* addr = m_builder.CreateInBoundsGEP(dynamic->getElement()->getLlvmType(m_context), data, index);
+        return ValueHandler::createAddress(*this, addr);
+    }
+
+    if (const auto* pointer = dyn_cast<TypePointer>(ast.expr->type)) {
+        auto* base = visit(*ast.expr).load();
+        auto* addr = m_builder.CreateInBoundsGEP(pointer->getBase()->getLlvmType(m_context), base, index);
+        return ValueHandler::createAddress(*this, addr);
+    }
+
+    if (const auto* vector = dyn_cast<TypeVector>(ast.expr->type)) {
+        if (!ast.flags.addressable) {
+            return { this, m_builder.CreateExtractElement(visit(*ast.expr).load(), index) };
+        }
+        llvm::Value* idxs[] = { llvm::ConstantInt::get(indexTy, 0), index };
+        auto* addr = m_builder.CreateInBoundsGEP(vector->getLlvmType(m_context), visit(*ast.expr).getAddress(), idxs);
+        return ValueHandler::createAddress(*this, addr);
+    }
+
+    const auto* array = llvm::cast<TypeArray>(ast.expr->type);
+    auto* base = visit(*ast.expr).getAddress();
+    if (auto lower = array->getLowerBound(); lower != 0) {
+        index = m_builder.CreateNSWSub(index, llvm::ConstantInt::get(indexTy, static_cast<uint64_t>(lower), true));
+    }
+
+    llvm::Value* idxs[] = { llvm::ConstantInt::get(indexTy, 0), index };
+    auto* addr = m_builder.CreateInBoundsGEP(array->getLlvmType(m_context), base, idxs);
+    return ValueHandler::createAddress(*this, addr);
+}
+
+ValueHandler CodeGen::visit(AstArrayExpr& ast) {
+    auto* type = llvm::cast<llvm::ArrayType>(ast.type->getLlvmType(m_context));
+
+    std::vector<llvm::Value*> values;
+    values.reserve(ast.elements.size());
+    bool isConstant = true;
+    for (auto* element : ast.elements) {
+        auto* value = visit(*element).load();
+        isConstant = isConstant && isa<llvm::Constant>(value);
+        values.emplace_back(value);
+    }
+
+    // missing elements are zero initialized
+    if (isConstant) {
+        std::vector<llvm::Constant*> constants;
+        constants.reserve(type->getNumElements());
+        for (auto* value : values) {
+            constants.emplace_back(llvm::cast<llvm::Constant>(value));
+        }
+        constants.resize(type->getNumElements(), llvm::Constant::getNullValue(type->getElementType()));
+        return { this, llvm::ConstantArray::get(type, constants) };
+    }
+
+    llvm::Value* aggregate = llvm::Constant::getNullValue(type);
+    for (unsigned index = 0; index < values.size(); index++) {
+        aggregate = m_builder.CreateInsertValue(aggregate, values[index], index);
+    }
+    return { this, aggregate };
+}
+
+/**
+ * Fixed size array bounds are folded, only UBOUND of a dynamic array
+ * is left to runtime
+ */
+ValueHandler CodeGen::visit(AstBoundExpr& ast) {
+    auto* length = m_builder.CreateExtractValue(visit(*ast.expr).load(), 1);
+    return { this, m_builder.CreateNSWSub(length, m_builder.getInt64(1)) };
+}
+
+ValueHandler CodeGen::visit(AstShuffleExpr& ast) {
+    auto* lhs = visit(*ast.lhs).load();
+    auto* rhs = ast.rhs != nullptr
+        ? visit(*ast.rhs).load()
+        : llvm::UndefValue::get(lhs->getType());
+    return { this, m_builder.CreateShuffleVector(lhs, rhs, ast.mask) };
+}
+
+ValueHandler CodeGen::visit(AstIntrinsicExpr& ast) {
+    return Gen::IntrinsicBuilder(*this, ast).build();
+}
+
 ValueHandler CodeGen::visit(AstCallExpr& ast) {
     auto* fn = llvm::cast<llvm::Function>(visit(*ast.callable).load());
 
@@ -447,6 +1024,16 @@ ValueHandler CodeGen::visit(AstCallExpr& ast) {
 
     auto* call = m_builder.CreateCall(llvm::FunctionCallee(fn), values, "");
     call->setTailCall(false);
+
+    // LLVM has no flatten, inline every call made from the function instead.
+    // Call site alwaysinline overrides callee's noinline, so skip those
+    if (m_flatten && !fn->hasFnAttribute(llvm::Attribute::NoInline)) {
+#if LLVM_VERSION_MAJOR >= 14
+        call->addFnAttr(llvm::Attribute::AlwaysInline);
+#else
+        call->addAttribute(llvm::AttributeList::FunctionIndex, llvm::Attribute::AlwaysInline);
+#endif
+    }
     return { this, call };
 }
 
@@ -489,16 +1076,7 @@ ValueHandler CodeGen::visit(AstUnaryExpr& ast) {
     switch (ast.tokenKind) {
     case TokenKind::Negate: {
         auto* value = visit(*ast.expr).load();
-
-        if (value->getType()->isIntegerTy()) {
-            return { this, m_builder.CreateNeg(value) };
-        }
-
-        if (value->getType()->isFloatingPointTy()) {
-            return { this, m_builder.CreateFNeg(value) };
-        }
-
-        llvm_unreachable("Unexpected unary operator");
+        return { this, createNeg(value, ast.expr->type) };
     }
     case TokenKind::LogicalNot: {
         auto value = visit(*ast.expr);
@@ -521,20 +1099,31 @@ ValueHandler CodeGen::visit(AstBinaryExpr& ast) {
 // Casting
 //------------------------------------------------------------------
 
+/**
+ * Scalars cast to a vector are converted to the element type and
+ * then splat across all lanes
+ */
 ValueHandler CodeGen::visit(AstCastExpr& ast) {
     auto* value = visit(*ast.expr).load();
 
-    bool srcIsSigned = ast.expr->type->isSignedIntegral();
-    bool dstIsSigned = ast.type->isSignedIntegral();
+    const auto* vector = dyn_cast<TypeVector>(ast.type);
+    const auto* type = vector != nullptr && !ast.expr->type->isVector()
+        ? vector->getElement()
+        : ast.type;
 
-    auto opcode = llvm::CastInst::getCastOpcode(
-        value,
-        srcIsSigned,
-        ast.type->getLlvmType(m_context),
-        dstIsSigned);
-    auto* casted = m_builder.CreateCast(opcode, value, ast.type->getLlvmType(m_context));
+    bool srcIsSigned = ast.expr->type->getScalarType()->isSignedIntegral();
+    bool dstIsSigned = type->getScalarType()->isSignedIntegral();
 
-    return { this, casted };
+    auto* llvmType = type->getLlvmType(m_context);
+    if (value->getType() != llvmType) {
+        auto opcode = llvm::CastInst::getCastOpcode(value, srcIsSigned, llvmType, dstIsSigned);
+        value = m_builder.CreateCast(opcode, value, llvmType);
+    }
+    if (type != ast.type) {
+        value = m_builder.CreateVectorSplat(vector->getLanes(), value);
+    }
+
+    return { this, value };
 }
 
 ValueHandler CodeGen::visit(AstIfExpr& ast) {
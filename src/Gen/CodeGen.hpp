@@ -8,6 +8,9 @@
 
 namespace lbc {
 class Context;
+class Symbol;
+class TypeRoot;
+class TypeDynamicArray;
 
 class CodeGen final : public AstVisitor<CodeGen, Gen::ValueHandler> {
 public:
@@ -27,6 +30,30 @@ public:
     void terminateBlock(llvm::BasicBlock* dest);
     void switchBlock(llvm::BasicBlock* block);
 
+    /// Create stack slot in the entry block of the current function,
+    /// aligned at least to the given alignment
+    [[nodiscard]] llvm::AllocaInst* createAlloca(llvm::Type* type, const Twine& name, llvm::MaybeAlign alignment = {});
+
+    /// Alignment of the variable, including one requested with [Align(n)].
+    /// Members only report alignment requested for them, as their
+    /// parent may be packed
+    [[nodiscard]] llvm::MaybeAlign getAlignment(const Symbol& symbol);
+
+    /// Number of live block scoped stack slots and dynamic arrays
+    [[nodiscard]] size_t getLifetimeDepth() const noexcept { return m_lifetimes.size(); }
+
+    /// End lifetime of block scoped slots and release dynamic arrays above
+    /// the depth. When branching out of a scope slots are not forgotten
+    void endLifetimes(size_t depth, bool forget = true);
+
+    /// Emit binary operation. Signed integer add, sub and mul
+    /// follow the overflow mode set in compile options
+    [[nodiscard]] llvm::Value* createBinOp(llvm::Instruction::BinaryOps op, llvm::Value* lhs, llvm::Value* rhs, const TypeRoot* type);
+
+    /// Negate the value, following the overflow mode for signed integers
+    [[nodiscard]] llvm::Value* createNeg(llvm::Value* value, const TypeRoot* type);
+
+
     AST_VISITOR_DECLARE_CONTENT_FUNCS()
 private:
     enum class Scope {
@@ -36,11 +63,24 @@ private:
 
     llvm::BasicBlock* getGlobalCtorBlock();
 
-    void declareFuncs(AstStmtList& ast);
-    void declareFunc(AstFuncDecl& ast);
+    void collectFuncs(AstStmtList& ast);
+    llvm::Function* getOrDeclareFunc(AstFuncDecl& ast);
+    void addFuncAttributes(llvm::Function* fn, const AstFuncDecl& ast);
+    void addTargetAttributes(llvm::Function* fn);
+    [[nodiscard]] llvm::FastMathFlags getFastMathFlags(const AstFuncDecl& ast) const;
+    static void addFastMathAttributes(llvm::Function* fn, llvm::FastMathFlags flags);
     void declareGlobalVar(AstVarDecl& ast);
     void declareLocalVar(AstVarDecl& ast);
+    void promoteLocals(llvm::Function* func);
+    llvm::Value* createCheckedBinOp(llvm::Intrinsic::ID id, llvm::Value* lhs, llvm::Value* rhs);
+    llvm::BasicBlock* getTrapBlock(llvm::Function* func);
     llvm::Constant* getStringConstant(StringRef str);
+    llvm::GlobalVariable* createConstantGlobal(llvm::Constant* value, const Twine& name);
+    llvm::Value* reserveArray(llvm::Value* array, llvm::Value* keep, llvm::Value* required, const TypeDynamicArray* type, bool growUnlikely);
+    void freeArrays(size_t depth);
+    void freeArray(llvm::AllocaInst* slot);
+    llvm::FunctionCallee getArrayReserveFunc();
+    llvm::FunctionCallee getArrayFreeFunc();
 
     Context& m_context;
     llvm::LLVMContext& m_llvmContext;
@@ -51,16 +91,30 @@ private:
     llvm::Function* m_globalCtorFunc = nullptr;
     llvm::IRBuilder<> m_builder;
     llvm::StringMap<llvm::Constant*> m_stringLiterals;
+    llvm::DenseMap<const Symbol*, AstFuncDecl*> m_funcDecls;
+    llvm::DenseMap<llvm::Function*, llvm::BasicBlock*> m_trapBlocks;
 
     llvm::ConstantInt* m_constantTrue;
     llvm::ConstantInt* m_constantFalse;
 
 
     bool m_declareAsGlobals = true;
+    unsigned m_blockScopes = 0;
+
+    struct ScopedSlot final {
+        llvm::AllocaInst* slot;
+        bool hasLifetime; // block scoped, has lifetime markers
+        bool ownsBuffer;  // dynamic array buffer to release
+    };
+    std::vector<ScopedSlot> m_lifetimes;
+    size_t m_funcLifetimeDepth = 0;
+    // calls made from a [Flatten] function are inlined
+    bool m_flatten = false;
 
     struct ControlEntry final {
         llvm::BasicBlock* continueBlock;
         llvm::BasicBlock* exitBlock;
+        size_t lifetimeDepth;
     };
     ControlFlowStack<ControlEntry> m_controlStack;
 };
@@ -8,6 +8,7 @@ using namespace lbc;
 using namespace Gen;
 
 llvm::CmpInst::Predicate lbc::Gen::getCmpPred(const TypeRoot* type, TokenKind op) noexcept {
+    type = type->getScalarType();
     if (const auto* integral = dyn_cast<TypeIntegral>(type)) {
         bool isSigned = integral->isSigned();
         switch (op) {
@@ -62,6 +63,7 @@ llvm::CmpInst::Predicate lbc::Gen::getCmpPred(const TypeRoot* type, TokenKind op
 }
 
 llvm::Instruction::BinaryOps lbc::Gen::getBinOpPred(const TypeRoot* type, TokenKind op) noexcept {
+    type = type->getScalarType();
     if (type->isIntegral()) {
         auto sign = type->isSignedIntegral();
         switch (op) {
@@ -14,10 +14,7 @@ using namespace value_handler_detail;
 
 ValueHandler ValueHandler::createTemp(CodeGen& gen, AstExpr& expr, StringRef name) noexcept {
     auto* value = gen.visit(expr).load();
-    auto* var = gen.getBuilder().CreateAlloca(
-        expr.type->getLlvmType(gen.getContext()),
-        nullptr,
-        name);
+    auto* var = gen.createAlloca(expr.type->getLlvmType(gen.getContext()), name);
     gen.getBuilder().CreateStore(value, var);
     return { &gen, { var, true } };
 }
@@ -28,14 +25,15 @@ ValueHandler ValueHandler::createTempOrConstant(CodeGen& gen, AstExpr& expr, Str
         return { &gen, { value, false } };
     }
 
-    auto* var = gen.getBuilder().CreateAlloca(
-        expr.type->getLlvmType(gen.getContext()),
-        nullptr,
-        name);
+    auto* var = gen.createAlloca(expr.type->getLlvmType(gen.getContext()), name);
     gen.getBuilder().CreateStore(value, var);
     return { &gen, { var, true } };
 }
 
+ValueHandler ValueHandler::createAddress(CodeGen& gen, llvm::Value* address) noexcept {
+    return { &gen, { address, true } };
+}
+
 ValueHandler::ValueHandler(CodeGen* gen, ValuePtr ptr) noexcept
 : PointerUnion{ ptr }, m_gen{ gen } {}
 
@@ -71,30 +69,30 @@ llvm::Value* ValueHandler::getAddress() const noexcept {
 
         llvm::SmallVector<llvm::Value*, 4> idxs;
         idxs.push_back(builder.getInt64(0));
-        auto* addr = m_gen->visit(*member->rhs).getAggregateAddress(lhs, idxs, true);
+        auto* addr = m_gen->visit(*member->rhs).getAggregateAddress(lhs, idxs);
         return builder.CreateGEP(addr, idxs);
     }
 
     llvm_unreachable("Unknown ValueHandler type");
 }
 
-llvm::Value* ValueHandler::getAggregateAddress(llvm::Value* base, IndexArray& idxs, bool terminal) const noexcept {
+llvm::Value* ValueHandler::getAggregateAddress(llvm::Value* base, IndexArray& idxs) const noexcept {
     // end of the member access chain
     if (auto* symbol = dyn_cast<Symbol*>()) {
-        auto& builder = m_gen->getBuilder();
-        idxs.push_back(builder.getInt32(symbol->getIndex()));
-        if (terminal && symbol->type()->isPointer()) {
-            base = builder.CreateGEP(base, idxs);
-            base = builder.CreateLoad(base);
-            idxs.pop_back_n(idxs.size() - 1);
-        }
+        const auto* udt = llvm::cast<TypeUDT>(symbol->getParent()->type());
+        idxs.push_back(m_gen->getBuilder().getInt32(udt->getElementIndex(*symbol)));
         return base;
     }
 
-    // middle of the chain
+    // middle of the chain, pointer members are followed to the pointee
     if (auto* member = dyn_cast<AstMemberAccess*>()) {
-        base = m_gen->visit(*member->lhs).getAggregateAddress(base, idxs, false);
-        return m_gen->visit(*member->rhs).getAggregateAddress(base, idxs, true);
+        base = m_gen->visit(*member->lhs).getAggregateAddress(base, idxs);
+        if (member->lhs->type->isPointer()) {
+            auto& builder = m_gen->getBuilder();
+            base = builder.CreateLoad(builder.CreateGEP(base, idxs));
+            idxs.pop_back_n(idxs.size() - 1);
+        }
+        return m_gen->visit(*member->rhs).getAggregateAddress(base, idxs);
     }
 
     llvm_unreachable("Unknown aggregate member access type");
@@ -110,10 +108,27 @@ llvm::Value* ValueHandler::load() const noexcept {
         return addr;
     }
 
-    return m_gen->getBuilder().CreateLoad(addr);
+    auto* load = m_gen->getBuilder().CreateLoad(addr);
+    if (auto alignment = getAlignment()) {
+        load->setAlignment(std::max(load->getAlign(), *alignment));
+    }
+    return load;
 }
 
 void ValueHandler::store(llvm::Value* val) const noexcept {
     auto* addr = getAddress();
-    m_gen->getBuilder().CreateStore(val, addr);
+    auto* store = m_gen->getBuilder().CreateStore(val, addr);
+    if (auto alignment = getAlignment()) {
+        store->setAlignment(std::max(store->getAlign(), *alignment));
+    }
+}
+
+llvm::MaybeAlign ValueHandler::getAlignment() const noexcept {
+    if (auto* symbol = dyn_cast<Symbol*>()) {
+        return m_gen->getAlignment(*symbol);
+    }
+    if (auto* member = dyn_cast<AstMemberAccess*>()) {
+        return m_gen->visit(*member->rhs).getAlignment();
+    }
+    return {};
 }
@@ -24,6 +24,9 @@ namespace Gen {
         /// Create temporary variable if expression is not a constant
         static ValueHandler createTempOrConstant(CodeGen& gen, AstExpr& expr, StringRef name = "") noexcept;
 
+        /// Refer to a value stored at the address, e.g. an array element
+        static ValueHandler createAddress(CodeGen& gen, llvm::Value* address) noexcept;
+
         constexpr ValueHandler() noexcept = default;
         ValueHandler(CodeGen* gen, Symbol* symbol) noexcept;
         ValueHandler(CodeGen* gen, llvm::Value* value) noexcept;
@@ -45,7 +48,8 @@ namespace Gen {
         ValueHandler(CodeGen* gen, value_handler_detail::ValuePtr ptr) noexcept;
 
         using IndexArray = llvm::SmallVectorImpl<llvm::Value*>;
-        [[nodiscard]] llvm::Value* getAggregateAddress(llvm::Value* base, IndexArray& idxs, bool terminal) const noexcept;
+        [[nodiscard]] llvm::Value* getAggregateAddress(llvm::Value* base, IndexArray& idxs) const noexcept;
+        [[nodiscard]] llvm::MaybeAlign getAlignment() const noexcept;
 
         CodeGen* m_gen = nullptr;
     };
@@ -96,6 +96,10 @@ void Lexer::next(Token& result) {
             return token(result, TokenKind::BracketOpen);
         case ']':
             return token(result, TokenKind::BracketClose);
+        case '{':
+            return token(result, TokenKind::BraceOpen);
+        case '}':
+            return token(result, TokenKind::BraceClose);
         case '+':
             return token(result, TokenKind::Plus);
         case '-':
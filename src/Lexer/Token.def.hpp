@@ -25,37 +25,44 @@
     _( ParenClose,      ")"   ) \
     _( BracketOpen,     "["   ) \
     _( BracketClose,    "]"   ) \
+    _( BraceOpen,       "{"   ) \
+    _( BraceClose,      "}"   ) \
     _( Ellipsis,        "..." )
 
 #define TOKEN_OPERATORS(_) \
     /* ID               Str     Prec    Type    Assoc   Kind       */ \
-    _( MemberAccess,    ".",    12,     Binary, Left,   Memory      ) \
+    _( MemberAccess,    ".",    14,     Binary, Left,   Memory      ) \
                                                                       \
-    _( AddressOf,       "@",    11,     Unary,  Left,   Memory      ) \
-    _( Dereference,     "*",    11,     Unary,  Left,   Memory      ) \
+    _( AddressOf,       "@",    13,     Unary,  Left,   Memory      ) \
+    _( Dereference,     "*",    13,     Unary,  Left,   Memory      ) \
                                                                       \
-    _( Negate,          "-",    10,     Unary,  Left,   Arithmetic  ) \
-    _( LogicalNot,      "NOT",  10,     Unary,  Left,   Logical     ) \
+    _( Negate,          "-",    12,     Unary,  Left,   Arithmetic  ) \
+    _( LogicalNot,      "NOT",  12,     Unary,  Left,   Logical     ) \
                                                                       \
-    _( Multiply,        "*",    9,      Binary, Left,   Arithmetic  ) \
-    _( Divide,          "/",    9,      Binary, Left,   Arithmetic  ) \
+    _( Multiply,        "*",    11,     Binary, Left,   Arithmetic  ) \
+    _( Divide,          "/",    11,     Binary, Left,   Arithmetic  ) \
                                                                       \
-    _( Modulus,         "MOD",  8,      Binary, Left,   Arithmetic  ) \
+    _( Modulus,         "MOD",  10,     Binary, Left,   Arithmetic  ) \
                                                                       \
-    _( Plus,            "+",    7,      Binary, Left,   Arithmetic  ) \
-    _( Minus,           "-",    7,      Binary, Left,   Arithmetic  ) \
+    _( Plus,            "+",    9,      Binary, Left,   Arithmetic  ) \
+    _( Minus,           "-",    9,      Binary, Left,   Arithmetic  ) \
                                                                       \
-    _( Equal,           "=",    6,      Binary, Left,   Comparison  ) \
-    _( NotEqual,        "<>",   6,      Binary, Left,   Comparison  ) \
+    _( ShiftLeft,       "SHL",  8,      Binary, Left,   Bitwise     ) \
+    _( ShiftRight,      "SHR",  8,      Binary, Left,   Bitwise     ) \
                                                                       \
-    _( LessThan,        "<",    5,      Binary, Left,   Comparison  ) \
-    _( LessOrEqual,     "<=",   5,      Binary, Left,   Comparison  ) \
-    _( GreaterThan,     ">",    5,      Binary, Left,   Comparison  ) \
-    _( GreaterOrEqual,  ">=",   5,      Binary, Left,   Comparison  ) \
+    _( Equal,           "=",    7,      Binary, Left,   Comparison  ) \
+    _( NotEqual,        "<>",   7,      Binary, Left,   Comparison  ) \
                                                                       \
-    _( LogicalAnd,      "AND",  4,      Binary, Left,   Logical     ) \
+    _( LessThan,        "<",    6,      Binary, Left,   Comparison  ) \
+    _( LessOrEqual,     "<=",   6,      Binary, Left,   Comparison  ) \
+    _( GreaterThan,     ">",    6,      Binary, Left,   Comparison  ) \
+    _( GreaterOrEqual,  ">=",   6,      Binary, Left,   Comparison  ) \
                                                                       \
-    _( LogicalOr,       "OR",   3,      Binary, Left,   Logical     ) \
+    _( LogicalAnd,      "AND",  5,      Binary, Left,   Logical     ) \
+                                                                      \
+    _( LogicalOr,       "OR",   4,      Binary, Left,   Logical     ) \
+                                                                      \
+    _( LogicalXor,      "XOR",  3,      Binary, Left,   Logical     ) \
                                                                       \
     _( Assign,          "=",    2,      Binary, Left,   Assignment  ) \
                                                                       \
@@ -63,7 +70,9 @@
 
 #define TOKEN_KEYWORDS(_) \
     _( Any,      "ANY"      ) \
+    _( Append,   "APPEND"   ) \
     _( As,       "AS"       ) \
+    _( Const,    "CONST"    ) \
     _( Continue, "CONTINUE" ) \
     _( Declare,  "DECLARE"  ) \
     _( Do,       "DO"       ) \
@@ -75,26 +84,35 @@
     _( Function, "FUNCTION" ) \
     _( If,       "IF"       ) \
     _( Import,   "IMPORT"   ) \
+    _( LBound,   "LBOUND"   ) \
     _( Loop,     "LOOP"     ) \
     _( Next,     "NEXT"     ) \
     _( Null,     "NULL"     ) \
+    _( Preserve, "PRESERVE" ) \
     _( Ptr,      "PTR"      ) \
+    _( Redim,    "REDIM"    ) \
     _( Return,   "RETURN"   ) \
+    _( Shuffle,  "SHUFFLE"  ) \
     _( Step,     "STEP"     ) \
     _( Sub,      "SUB"      ) \
     _( Then,     "THEN"     ) \
     _( To,       "TO"       ) \
     _( True,     "TRUE"     ) \
     _( Type,     "TYPE"     ) \
+    _( UBound,   "UBOUND"   ) \
     _( Until,    "UNTIL"    ) \
     _( Var,      "VAR"      ) \
+    _( Vector,   "VECTOR"   ) \
     _( While,    "WHILE"    )
 
 #define TOKEN_OPERAOTR_KEYWORD_MAP(_) \
     _( LogicalNot ) \
     _( Modulus    ) \
     _( LogicalAnd ) \
-    _( LogicalOr  )
+    _( LogicalOr  ) \
+    _( LogicalXor ) \
+    _( ShiftLeft  ) \
+    _( ShiftRight )
 
 // All tokens combined
 #define ALL_TOKENS(_) \
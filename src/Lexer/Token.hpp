@@ -15,6 +15,7 @@ enum class TokenKind {
 enum class OperatorType {
     Arithmetic,
     Logical,
+    Bitwise,
     Comparison,
     Memory,
     Assignment
@@ -83,6 +83,8 @@ AstStmtList* Parser::stmtList() {
  *   | RETURN
  *   | EXIT
  *   | CONTINUE
+ *   | REDIM
+ *   | APPEND
  *   | Expression
  *   .
  */
@@ -114,6 +116,10 @@ AstStmt* Parser::statement() {
         return kwContinue();
     case TokenKind::Exit:
         return kwExit();
+    case TokenKind::Redim:
+        return kwRedim();
+    case TokenKind::Append:
+        return kwAppend();
     default:
         break;
     }
@@ -171,6 +177,7 @@ AstImport* Parser::kwImport() {
  *   = [
  *     [ AttributeList ]
  *     ( VAR
+ *     | CONST
  *     | DECLARE
  *     | FUNCTION
  *     | SUB
@@ -184,6 +191,8 @@ AstStmt* Parser::declaration() {
     switch (m_token.getKind()) {
     case TokenKind::Var:
         return kwVar(attribs);
+    case TokenKind::Const:
+        return kwConst(attribs);
     case TokenKind::Declare:
         return kwDeclare(attribs);
     case TokenKind::Function:
@@ -285,7 +294,7 @@ AstExprList* Parser::attributeArgList() {
  * VAR
  *   = "VAR" identifier
  *   ( "=" Expression
- *   | "AS" TypeExpr [ "=" Expression ]
+ *   | [ ArrayBounds ] "AS" TypeExpr [ "=" Expression ]
  *   )
  *   .
  */
@@ -302,7 +311,14 @@ AstVarDecl* Parser::kwVar(AstAttributeList* attribs) {
     AstTypeExpr* type = nullptr;
     AstExpr* expr = nullptr;
 
-    if (accept(TokenKind::As)) {
+    if (m_token.is(TokenKind::ParenOpen)) {
+        auto bounds = arrayBounds();
+        consume(TokenKind::As);
+        type = typeExpr(std::move(bounds));
+        if (accept(TokenKind::Assign)) {
+            expr = expression();
+        }
+    } else if (accept(TokenKind::As)) {
         type = typeExpr();
         if (accept(TokenKind::Assign)) {
             expr = expression();
@@ -321,6 +337,46 @@ AstVarDecl* Parser::kwVar(AstAttributeList* attribs) {
         expr);
 }
 
+//----------------------------------------
+// CONST
+//----------------------------------------
+
+/**
+ * CONST
+ *   = "CONST" identifier
+ *     [ [ ArrayBounds ] "AS" TypeExpr ] "=" Expression
+ *   .
+ */
+AstConstDecl* Parser::kwConst(AstAttributeList* attribs) {
+    // assume m_token == CONST
+    assert(m_token.is(TokenKind::Const));
+    auto start = attribs != nullptr ? attribs->range.Start : m_token.range().Start;
+    advance();
+
+    expect(TokenKind::Identifier);
+    auto id = m_token.getStringValue();
+    advance();
+
+    AstTypeExpr* type = nullptr;
+    if (m_token.is(TokenKind::ParenOpen)) {
+        auto bounds = arrayBounds();
+        consume(TokenKind::As);
+        type = typeExpr(std::move(bounds));
+    } else if (accept(TokenKind::As)) {
+        type = typeExpr();
+    }
+
+    consume(TokenKind::Assign);
+    auto* expr = expression();
+
+    return m_context.create<AstConstDecl>(
+        llvm::SMRange{ start, m_endLoc },
+        id,
+        attribs,
+        type,
+        expr);
+}
+
 //----------------------------------------
 // DECLARE
 //----------------------------------------
@@ -413,7 +469,7 @@ AstFuncParamList* Parser::funcParamList(bool& isVariadic) {
 
 /**
  * FuncParam
- *  = id "AS" TypeExpr
+ *  = id [ "(" ")" ] "AS" TypeExpr
  *  .
  */
 AstFuncParamDecl* Parser::funcParam() {
@@ -423,8 +479,15 @@ AstFuncParamDecl* Parser::funcParam() {
     auto id = m_token.getStringValue();
     advance();
 
+    // only dynamic arrays can be passed
+    std::vector<AstArrayBound> bounds;
+    if (accept(TokenKind::ParenOpen)) {
+        consume(TokenKind::ParenClose);
+        bounds.push_back({ nullptr, nullptr });
+    }
+
     consume(TokenKind::As);
-    auto* type = typeExpr();
+    auto* type = typeExpr(std::move(bounds));
 
     return m_context.create<AstFuncParamDecl>(
         llvm::SMRange{ start, m_endLoc },
@@ -496,7 +559,7 @@ AstDeclList* Parser::typeDeclList() {
 
 /**
  * typeMember
- *   = id "AS" TypeExpr
+ *   = id [ ArrayBounds ] "AS" TypeExpr
  *   .
  */
 AstDecl* Parser::typeMember(AstAttributeList* attribs) {
@@ -506,9 +569,14 @@ AstDecl* Parser::typeMember(AstAttributeList* attribs) {
     auto id = m_token.getStringValue();
     advance();
 
+    std::vector<AstArrayBound> bounds;
+    if (m_token.is(TokenKind::ParenOpen)) {
+        bounds = arrayBounds();
+    }
+
     consume(TokenKind::As);
 
-    auto* type = typeExpr();
+    auto* type = typeExpr(std::move(bounds));
 
     return m_context.create<AstVarDecl>(
         llvm::SMRange{ start, m_endLoc },
@@ -908,14 +976,65 @@ AstContinuationStmt* Parser::kwExit() {
         std::move(returnControl));
 }
 
+//----------------------------------------
+// Dynamic arrays
+//----------------------------------------
+
+/**
+ * REDIM
+ *   = "REDIM" [ "PRESERVE" ] identifier "(" Expression ")"
+ *   .
+ */
+AstRedimStmt* Parser::kwRedim() {
+    // assume m_token == REDIM
+    assert(m_token.is(TokenKind::Redim));
+    auto start = m_token.range().Start;
+    advance();
+
+    auto preserve = accept(TokenKind::Preserve);
+    auto* expr = identifier();
+    consume(TokenKind::ParenOpen);
+    auto* upper = expression();
+    consume(TokenKind::ParenClose);
+
+    return m_context.create<AstRedimStmt>(
+        llvm::SMRange{ start, m_endLoc },
+        expr,
+        upper,
+        preserve);
+}
+
+/**
+ * APPEND
+ *   = "APPEND" identifier "," Expression
+ *   .
+ */
+AstAppendStmt* Parser::kwAppend() {
+    // assume m_token == APPEND
+    assert(m_token.is(TokenKind::Append));
+    auto start = m_token.range().Start;
+    advance();
+
+    auto* expr = identifier();
+    consume(TokenKind::Comma);
+    auto* value = expression();
+
+    return m_context.create<AstAppendStmt>(
+        llvm::SMRange{ start, m_endLoc },
+        expr,
+        value);
+}
+
 //----------------------------------------
 // Types
 //----------------------------------------
 
 /**
- * TypeExpr = ( identExpr | Any ) { "PTR" } .
+ * TypeExpr = ( identExpr | Any ) [ "VECTOR" "(" expression ")" ] { "PTR" } .
+ *
+ * Array bounds precede the AS keyword, but are part of the type
  */
-AstTypeExpr* Parser::typeExpr() {
+AstTypeExpr* Parser::typeExpr(std::vector<AstArrayBound> bounds) {
     auto start = m_token.range().Start;
     auto kind = m_token.getKind();
 
@@ -926,6 +1045,13 @@ AstTypeExpr* Parser::typeExpr() {
         ident = identifier();
     }
 
+    AstExpr* lanes = nullptr;
+    if (accept(TokenKind::Vector)) {
+        consume(TokenKind::ParenOpen);
+        lanes = expression();
+        consume(TokenKind::ParenClose);
+    }
+
     auto deref = 0;
     while (accept(TokenKind::Ptr)) {
         deref++;
@@ -935,7 +1061,34 @@ AstTypeExpr* Parser::typeExpr() {
         llvm::SMRange{ start, m_endLoc },
         ident,
         kind,
-        deref);
+        deref,
+        std::move(bounds),
+        lanes);
+}
+
+/**
+ * ArrayBounds = "(" [ ArrayBound { "," ArrayBound } ] ")" .
+ * ArrayBound  = Expression [ "TO" Expression ] .
+ */
+std::vector<AstArrayBound> Parser::arrayBounds() {
+    consume(TokenKind::ParenOpen);
+
+    std::vector<AstArrayBound> bounds;
+    if (accept(TokenKind::ParenClose)) {
+        bounds.push_back({ nullptr, nullptr });
+        return bounds;
+    }
+    do {
+        auto* expr = expression();
+        if (accept(TokenKind::To)) {
+            bounds.push_back({ expr, expression() });
+        } else {
+            bounds.push_back({ nullptr, expr });
+        }
+    } while (accept(TokenKind::Comma));
+
+    consume(TokenKind::ParenClose);
+    return bounds;
 }
 
 //----------------------------------------
@@ -978,7 +1131,7 @@ AstExpr* Parser::expression(ExprFlags flags) {
 }
 
 /**
- * factor = primary { <Right Unary Op> | "AS" TypeExpr } .
+ * factor = primary { <Right Unary Op> | "AS" TypeExpr | "[" expression "]" } .
  */
 AstExpr* Parser::factor() {
     auto start = m_token.range().Start;
@@ -1005,6 +1158,17 @@ AstExpr* Parser::factor() {
             expr = cast;
             continue;
         }
+
+        // "[" expression "]"
+        if (accept(TokenKind::BracketOpen)) {
+            auto* index = expression();
+            consume(TokenKind::BracketClose);
+            expr = m_context.create<AstIndexExpr>(
+                llvm::SMRange{ start, m_endLoc },
+                expr,
+                index);
+            continue;
+        }
         break;
     }
     return expr;
@@ -1017,6 +1181,9 @@ AstExpr* Parser::factor() {
  *         | "(" expression ")"
  *         | <Left Unary Op> [ factor { <Binary Op> expression } ]
  *         | IfExpr
+ *         | ArrayExpr
+ *         | BoundExpr
+ *         | ShuffleExpr
   *        .
  */
 AstExpr* Parser::primary() {
@@ -1044,6 +1211,18 @@ AstExpr* Parser::primary() {
         return ifExpr();
     }
 
+    if (m_token.is(TokenKind::BraceOpen)) {
+        return arrayExpr();
+    }
+
+    if (m_token.isOneOf(TokenKind::LBound, TokenKind::UBound)) {
+        return boundExpr();
+    }
+
+    if (m_token.is(TokenKind::Shuffle)) {
+        return shuffleExpr();
+    }
+
     replace(TokenKind::Minus, TokenKind::Negate);
     replace(TokenKind::Multiply, TokenKind::Dereference);
     if (m_token.isUnary() && m_token.isLeftToRight()) {
@@ -1173,6 +1352,76 @@ AstIfExpr* Parser::ifExpr() {
         falseExpr);
 }
 
+/**
+ * ArrayExpr = "{" [ expression { "," expression } ] "}" .
+ */
+AstArrayExpr* Parser::arrayExpr() {
+    // assume m_token == {
+    assert(m_token.is(TokenKind::BraceOpen));
+    auto start = m_token.range().Start;
+    advance();
+
+    std::vector<AstExpr*> elements;
+    while (m_token.isNot(TokenKind::BraceClose)) {
+        elements.emplace_back(expression());
+        if (!accept(TokenKind::Comma)) {
+            break;
+        }
+    }
+    consume(TokenKind::BraceClose);
+
+    return m_context.create<AstArrayExpr>(
+        llvm::SMRange{ start, m_endLoc },
+        std::move(elements));
+}
+
+/**
+ * BoundExpr = ( "LBOUND" | "UBOUND" ) "(" expression ")" .
+ */
+AstBoundExpr* Parser::boundExpr() {
+    auto start = m_token.range().Start;
+    auto kind = m_token.getKind();
+    advance();
+
+    consume(TokenKind::ParenOpen);
+    auto* expr = expression();
+    consume(TokenKind::ParenClose);
+
+    return m_context.create<AstBoundExpr>(
+        llvm::SMRange{ start, m_endLoc },
+        kind,
+        expr);
+}
+
+/**
+ * ShuffleExpr = "SHUFFLE" "(" expression [ "," expression ] "," ArrayExpr ")" .
+ */
+AstShuffleExpr* Parser::shuffleExpr() {
+    // assume m_token == SHUFFLE
+    assert(m_token.is(TokenKind::Shuffle));
+    auto start = m_token.range().Start;
+    advance();
+
+    consume(TokenKind::ParenOpen);
+    auto* lhs = expression();
+    consume(TokenKind::Comma);
+
+    AstExpr* rhs = nullptr;
+    if (m_token.isNot(TokenKind::BraceOpen)) {
+        rhs = expression();
+        consume(TokenKind::Comma);
+    }
+    expect(TokenKind::BraceOpen);
+    auto* mask = arrayExpr();
+    consume(TokenKind::ParenClose);
+
+    return m_context.create<AstShuffleExpr>(
+        llvm::SMRange{ start, m_endLoc },
+        lhs,
+        rhs,
+        mask);
+}
+
 /**
  * literal = stringLiteral
  *         | IntegerLiteral
@@ -10,6 +10,7 @@ class Context;
 class Lexer;
 class DiagnosticEngine;
 struct AstIfStmtBlock;
+struct AstArrayBound;
 enum class Diag;
 AST_FORWARD_DECLARE()
 
@@ -50,8 +51,12 @@ private:
     [[nodiscard]] AstLiteralExpr* literal();
     [[nodiscard]] AstCallExpr* callExpr();
     [[nodiscard]] AstIfExpr* ifExpr();
+    [[nodiscard]] AstArrayExpr* arrayExpr();
+    [[nodiscard]] AstBoundExpr* boundExpr();
+    [[nodiscard]] AstShuffleExpr* shuffleExpr();
     [[nodiscard]] AstExprList* expressionList();
     [[nodiscard]] AstVarDecl* kwVar(AstAttributeList* attribs);
+    [[nodiscard]] AstConstDecl* kwConst(AstAttributeList* attribs);
     [[nodiscard]] AstIfStmt* kwIf();
     [[nodiscard]] AstIfStmtBlock ifBlock();
     [[nodiscard]] AstIfStmtBlock thenBlock(std::vector<AstVarDecl*> decls, AstExpr* expr);
@@ -59,10 +64,13 @@ private:
     [[nodiscard]] AstDoLoopStmt* kwDo();
     [[nodiscard]] AstContinuationStmt* kwContinue();
     [[nodiscard]] AstContinuationStmt* kwExit();
+    [[nodiscard]] AstRedimStmt* kwRedim();
+    [[nodiscard]] AstAppendStmt* kwAppend();
     [[nodiscard]] AstAttributeList* attributeList();
     [[nodiscard]] AstAttribute* attribute();
     [[nodiscard]] AstExprList* attributeArgList();
-    [[nodiscard]] AstTypeExpr* typeExpr();
+    [[nodiscard]] AstTypeExpr* typeExpr(std::vector<AstArrayBound> bounds = {});
+    [[nodiscard]] std::vector<AstArrayBound> arrayBounds();
     [[nodiscard]] AstFuncDecl* kwDeclare(AstAttributeList* attribs);
     [[nodiscard]] AstFuncDecl* funcSignature(llvm::SMLoc start, AstAttributeList* attribs, bool hasImpl);
     [[nodiscard]] AstFuncParamList* funcParamList(bool& isVariadic);
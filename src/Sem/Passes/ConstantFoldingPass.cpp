@@ -2,14 +2,17 @@
 // Created by Albert Varaksin on 05/05/2021.
 //
 #include "ConstantFoldingPass.hpp"
+#include "Driver/CompileOptions.hpp"
 #include "Driver/Context.hpp"
+#include "Symbol/Symbol.hpp"
 #include "Type/Type.hpp"
+#include <llvm/Support/MathExtras.h>
 using namespace lbc;
 using namespace Sem;
 
 namespace {
 template<typename BASE, typename T>
-constexpr inline BASE castLiteral(const AstLiteralExpr& ast) {
+constexpr inline BASE castLiteral(const AstLiteralExpr::Value& value) {
     constexpr auto visitor = [](const auto& val) -> T {
         using R = std::decay_t<decltype(val)>;
         if constexpr (std::is_convertible_v<R, T>) {
@@ -18,7 +21,163 @@ constexpr inline BASE castLiteral(const AstLiteralExpr& ast) {
             llvm_unreachable("Unsupported type conversion");
         }
     };
-    return static_cast<BASE>(std::visit(visitor, ast.value));
+    return static_cast<BASE>(std::visit(visitor, value));
+}
+
+/**
+ * Integral arithmetic wraps around at the width of T, same as LLVM
+ * instructions. Division by zero and signed MIN / -1 are undefined
+ * and left to be evaluated at runtime.
+ */
+template<typename T>
+constexpr inline std::optional<T> arithmetic(TokenKind op, T lhs, T rhs) noexcept {
+    if constexpr (std::is_integral_v<T>) {
+        using U = std::make_unsigned_t<T>;
+        const auto left = static_cast<uint64_t>(static_cast<U>(lhs));
+        const auto right = static_cast<uint64_t>(static_cast<U>(rhs));
+        switch (op) {
+        case TokenKind::Plus:
+            return static_cast<T>(static_cast<U>(left + right));
+        case TokenKind::Minus:
+            return static_cast<T>(static_cast<U>(left - right));
+        case TokenKind::Multiply:
+            return static_cast<T>(static_cast<U>(left * right));
+        case TokenKind::Divide:
+        case TokenKind::Modulus:
+            if (rhs == 0) {
+                return std::nullopt;
+            }
+            if constexpr (std::is_signed_v<T>) {
+                if (lhs == std::numeric_limits<T>::min() && rhs == -1) {
+                    return std::nullopt;
+                }
+            }
+            if (op == TokenKind::Divide) {
+                return static_cast<T>(lhs / rhs);
+            }
+            return static_cast<T>(lhs % rhs);
+        default:
+            llvm_unreachable("Unknown binary op");
+        }
+    } else {
+        switch (op) {
+        case TokenKind::Plus:
+            return lhs + rhs;
+        case TokenKind::Minus:
+            return lhs - rhs;
+        case TokenKind::Multiply:
+            return lhs * rhs;
+        case TokenKind::Divide:
+            return lhs / rhs;
+        case TokenKind::Modulus:
+            return std::fmod(lhs, rhs);
+        default:
+            llvm_unreachable("Unknown binary op");
+        }
+    }
+}
+
+template<typename T>
+inline bool signedOverflow(TokenKind op, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs) {
+    if constexpr (std::is_integral_v<T> && std::is_signed_v<T>) {
+        const auto left = castLiteral<T, T>(lhs);
+        const auto right = castLiteral<T, T>(rhs);
+        T result{};
+        switch (op) {
+        case TokenKind::Plus:
+            return llvm::AddOverflow(left, right, result) != 0;
+        case TokenKind::Minus:
+            return llvm::SubOverflow(left, right, result) != 0;
+        case TokenKind::Multiply:
+            return llvm::MulOverflow(left, right, result) != 0;
+        default:
+            return false;
+        }
+    } else {
+        return false;
+    }
+}
+
+/**
+ * Shift amount is masked to the width of T, same as generated code
+ */
+template<typename T>
+constexpr inline std::optional<T> bitwise(TokenKind op, T lhs, T rhs) noexcept {
+    using U = std::make_unsigned_t<T>;
+    switch (op) {
+    case TokenKind::LogicalAnd:
+        return static_cast<T>(lhs & rhs);
+    case TokenKind::LogicalOr:
+        return static_cast<T>(lhs | rhs);
+    case TokenKind::LogicalXor:
+        return static_cast<T>(lhs ^ rhs);
+    case TokenKind::ShiftLeft:
+    case TokenKind::ShiftRight: {
+        const auto amount = static_cast<U>(static_cast<U>(rhs) & (sizeof(T) * CHAR_BIT - 1));
+        if (op == TokenKind::ShiftLeft) {
+            return static_cast<T>(static_cast<U>(lhs) << amount);
+        }
+        return static_cast<T>(lhs >> amount);
+    }
+    default:
+        llvm_unreachable("Unknown bitwise op");
+    }
+}
+
+/**
+ * Floating point comparisons follow the predicates used by codegen:
+ * ordered, except for `<>`, which is true for NaN
+ */
+template<typename T>
+constexpr inline bool comparison(TokenKind op, T lhs, T rhs) noexcept {
+    switch (op) {
+    case TokenKind::Equal:
+        return lhs == rhs;
+    case TokenKind::NotEqual:
+        return lhs != rhs;
+    case TokenKind::LessThan:
+        return lhs < rhs;
+    case TokenKind::LessOrEqual:
+        return lhs <= rhs;
+    case TokenKind::GreaterOrEqual:
+        return lhs >= rhs;
+    case TokenKind::GreaterThan:
+        return lhs > rhs;
+    default:
+        llvm_unreachable("Unknown comparison op");
+    }
+}
+
+template<typename BASE, typename T>
+inline std::optional<AstLiteralExpr::Value> binaryLiteral(TokenKind op, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs) {
+    const auto left = castLiteral<T, T>(lhs);
+    const auto right = castLiteral<T, T>(rhs);
+
+    switch (Token::getOperatorType(op)) {
+    case OperatorType::Comparison:
+        return comparison(op, left, right);
+    case OperatorType::Arithmetic:
+        if constexpr (!std::is_same_v<T, bool>) {
+            if (auto result = arithmetic(op, left, right)) {
+                return static_cast<BASE>(*result);
+            }
+        }
+        return std::nullopt;
+    case OperatorType::Logical:
+    case OperatorType::Bitwise:
+        if constexpr (std::is_same_v<T, bool>) {
+            if (op == TokenKind::LogicalXor) {
+                return left != right;
+            }
+        } else if constexpr (std::is_integral_v<T>) {
+            if (auto result = bitwise(op, left, right)) {
+                return static_cast<BASE>(*result);
+            }
+        }
+        return std::nullopt;
+    default:
+        return std::nullopt;
+    }
 }
 } // namespace
 
@@ -29,6 +188,9 @@ void ConstantFoldingPass::fold(AstExpr*& ast) {
 
     AstExpr* replace = nullptr;
     switch (ast->kind) {
+    case AstKind::IdentExpr:
+        replace = visitIdentExpr(static_cast<AstIdentExpr&>(*ast));
+        break;
     case AstKind::UnaryExpr:
         replace = visitUnaryExpr(static_cast<AstUnaryExpr&>(*ast));
         break;
@@ -41,6 +203,9 @@ void ConstantFoldingPass::fold(AstExpr*& ast) {
     case AstKind::IfExpr:
         replace = visitIfExpr(static_cast<AstIfExpr&>(*ast));
         break;
+    case AstKind::BoundExpr:
+        replace = visitBoundExpr(static_cast<AstBoundExpr&>(*ast));
+        break;
     default:
         return;
     }
@@ -49,19 +214,52 @@ void ConstantFoldingPass::fold(AstExpr*& ast) {
     }
 }
 
+AstExpr* ConstantFoldingPass::visitIdentExpr(const AstIdentExpr& ast) {
+    if (ast.symbol == nullptr) {
+        return nullptr;
+    }
+    auto* constant = ast.symbol->getConstantValue();
+    if (constant == nullptr) {
+        return nullptr;
+    }
+
+    auto* repl = m_context.create<AstLiteralExpr>(ast.range, constant->value);
+    repl->type = constant->type;
+    return repl;
+}
+
+/**
+ * Bounds of fixed size arrays are known, dynamic arrays always start at 0
+ */
+AstExpr* ConstantFoldingPass::visitBoundExpr(const AstBoundExpr& ast) {
+    int64_t value = 0;
+    if (const auto* array = dyn_cast<TypeArray>(ast.expr->type)) {
+        value = ast.tokenKind == TokenKind::LBound ? array->getLowerBound() : array->getUpperBound();
+    } else if (ast.tokenKind == TokenKind::UBound) {
+        return nullptr;
+    }
+
+    auto* repl = m_context.create<AstLiteralExpr>(ast.range, static_cast<uint64_t>(value));
+    repl->type = ast.type;
+    return repl;
+}
+
 AstExpr* ConstantFoldingPass::visitUnaryExpr(const AstUnaryExpr& ast) {
     auto* literal = dyn_cast<AstLiteralExpr>(ast.expr);
     if (literal == nullptr) {
         return nullptr;
     }
+    if (ast.tokenKind == TokenKind::Negate && trapsOverflow(TokenKind::Minus, ast.type, uint64_t{ 0 }, literal->value)) {
+        return nullptr;
+    }
 
-    auto value = unary(ast.tokenKind, *literal);
+    auto value = unary(ast.tokenKind, literal->value);
     auto* repl = m_context.create<AstLiteralExpr>(ast.range, value);
     repl->type = ast.type;
     return repl;
 }
 
-AstLiteralExpr::Value ConstantFoldingPass::unary(TokenKind op, const AstLiteralExpr& ast) {
+AstLiteralExpr::Value ConstantFoldingPass::unary(TokenKind op, const AstLiteralExpr::Value& operand) {
     switch (op) {
     case TokenKind::Negate: {
         constexpr auto visitor = Visitor{
@@ -75,25 +273,27 @@ AstLiteralExpr::Value ConstantFoldingPass::unary(TokenKind op, const AstLiteralE
                 llvm_unreachable("Non supported type");
             }
         };
-        return std::visit(visitor, ast.value);
+        return std::visit(visitor, operand);
     }
     case TokenKind::LogicalNot: {
         constexpr auto visitor = Visitor{
             [](bool value) -> AstLiteralExpr::Value {
                 return !value;
             },
+            [](uint64_t value) -> AstLiteralExpr::Value {
+                return ~value;
+            },
             [](auto /*value*/) -> AstLiteralExpr::Value {
                 llvm_unreachable("Non supported type");
             }
         };
-        return std::visit(visitor, ast.value);
+        return std::visit(visitor, operand);
     }
     default:
         llvm_unreachable("Unsupported unary operation");
     }
 }
 
-
 AstExpr* ConstantFoldingPass::visitIfExpr(AstIfExpr& ast) {
     if (auto* expr = dyn_cast<AstLiteralExpr>(ast.expr)) {
         if (std::get<bool>(expr->value)) {
@@ -156,43 +356,119 @@ AstExpr* ConstantFoldingPass::optimizeIifToCast(AstIfExpr& ast) {
     return nullptr;
 }
 
-AstExpr* ConstantFoldingPass::visitBinaryExpr(AstBinaryExpr& /*ast*/) {
-    // TODO
-    return nullptr;
+AstExpr* ConstantFoldingPass::visitBinaryExpr(AstBinaryExpr& ast) {
+    auto* lhs = dyn_cast<AstLiteralExpr>(ast.lhs);
+    if (lhs == nullptr) {
+        return nullptr;
+    }
+
+    // short circuiting: rhs is only evaluated when lhs does not decide the result
+    if (ast.type->isBoolean()) {
+        if (ast.tokenKind == TokenKind::LogicalAnd) {
+            return std::get<bool>(lhs->value) ? ast.rhs : lhs;
+        }
+        if (ast.tokenKind == TokenKind::LogicalOr) {
+            return std::get<bool>(lhs->value) ? lhs : ast.rhs;
+        }
+    }
+
+    auto* rhs = dyn_cast<AstLiteralExpr>(ast.rhs);
+    if (rhs == nullptr) {
+        return nullptr;
+    }
+
+    if (trapsOverflow(ast.tokenKind, ast.lhs->type, lhs->value, rhs->value)) {
+        return nullptr;
+    }
+
+    auto value = binary(ast.tokenKind, ast.lhs->type, lhs->value, rhs->value);
+    if (!value) {
+        return nullptr;
+    }
+
+    auto* repl = m_context.create<AstLiteralExpr>(ast.range, *value);
+    repl->type = ast.type;
+    return repl;
+}
+
+std::optional<AstLiteralExpr::Value> ConstantFoldingPass::binary(TokenKind op, const TypeRoot* type, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs) {
+    // clang-format off
+    if (const auto* integral = dyn_cast<TypeIntegral>(type)) {
+        #define INTEGRAL(ID, STR, KIND, BITS, SIGNED, TYPE)                          \
+            if (integral->getBits() == (BITS) && integral->isSigned() == (SIGNED)) { \
+                return binaryLiteral<uint64_t, TYPE>(op, lhs, rhs);                  \
+            }
+        INTEGRAL_TYPES(INTEGRAL)
+        #undef INTEGRAL
+    } else if (const auto* fp = dyn_cast<TypeFloatingPoint>(type)) {
+        #define FLOATINGPOINT(ID, STR, KIND, BITS, TYPE)            \
+            if (fp->getBits() == (BITS)) {                          \
+                return binaryLiteral<double, TYPE>(op, lhs, rhs); \
+            }
+        FLOATINGPOINT_TYPES(FLOATINGPOINT)
+        #undef FLOATINGPOINT
+    } else if (type->isBoolean()) {
+        return binaryLiteral<bool, bool>(op, lhs, rhs);
+    }
+    // clang-format on
+    return std::nullopt;
+}
+
+/**
+ * Folding wraps around. With -ftrapv overflowing expressions
+ * are left for generated code to trap at runtime
+ */
+bool ConstantFoldingPass::trapsOverflow(TokenKind op, const TypeRoot* type, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs) const {
+    return m_context.getOptions().getOverflowMode() == CompileOptions::OverflowMode::Trap
+        && overflows(op, type, lhs, rhs);
+}
+
+bool ConstantFoldingPass::overflows(TokenKind op, const TypeRoot* type, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs) {
+    // clang-format off
+    if (const auto* integral = dyn_cast<TypeIntegral>(type)) {
+        #define INTEGRAL(ID, STR, KIND, BITS, SIGNED, TYPE)                          \
+            if (integral->getBits() == (BITS) && integral->isSigned() == (SIGNED)) { \
+                return signedOverflow<TYPE>(op, lhs, rhs);                           \
+            }
+        INTEGRAL_TYPES(INTEGRAL)
+        #undef INTEGRAL
+    }
+    // clang-format on
+    return false;
 }
 
 AstExpr* ConstantFoldingPass::visitCastExpr(const AstCastExpr& ast) {
     auto* literal = dyn_cast<AstLiteralExpr>(ast.expr);
-    if (literal == nullptr) {
+    if (literal == nullptr || ast.type->isVector()) {
         return nullptr;
     }
 
-    auto value = cast(ast.type, *literal);
+    auto value = cast(ast.type, literal->type, literal->value);
     auto* repl = m_context.create<AstLiteralExpr>(ast.range, value);
     repl->type = ast.type;
     return repl;
 }
 
-AstLiteralExpr::Value ConstantFoldingPass::cast(const TypeRoot* type, const AstLiteralExpr& ast) {
+AstLiteralExpr::Value ConstantFoldingPass::cast(const TypeRoot* type, const TypeRoot* from, const AstLiteralExpr::Value& value) {
     // clang-format off
     if (const auto* integral = dyn_cast<TypeIntegral>(type)) {
         #define INTEGRAL(ID, STR, KIND, BITS, SIGNED, TYPE)                          \
             if (integral->getBits() == (BITS) && integral->isSigned() == (SIGNED)) { \
-                return castLiteral<uint64_t, TYPE>(ast);                         \
+                return castLiteral<uint64_t, TYPE>(value);                       \
             }
         INTEGRAL_TYPES(INTEGRAL)
         #undef INTEGRAL
     } else if (const auto* fp = dyn_cast<TypeFloatingPoint>(type)) {
         #define FLOATINGPOINT(ID, STR, KIND, BITS, TYPE)   \
             if (fp->getBits() == (BITS)) {                 \
-                return castLiteral<double, TYPE>(ast); \
+                return castLiteral<double, TYPE>(value); \
             }
         FLOATINGPOINT_TYPES(FLOATINGPOINT)
-        #undef INTEGRAL
+        #undef FLOATINGPOINT
     } else if (type->isBoolean()) {
-        return castLiteral<bool, bool>(ast);
-    } else if (ast.type->isAnyPointer()) {
-        return ast.value;
+        return castLiteral<bool, bool>(value);
+    } else if (from->isAnyPointer()) {
+        return value;
     }
     // clang-format on
     llvm_unreachable("Unsupported castLiteral");
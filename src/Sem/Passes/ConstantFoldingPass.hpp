@@ -19,14 +19,22 @@ namespace Sem {
 
         void fold(AstExpr*& ast);
 
+        /// Operations on literal values, also used by FuncEvaluatorPass
+        [[nodiscard]] static AstLiteralExpr::Value unary(TokenKind op, const AstLiteralExpr::Value& operand);
+        [[nodiscard]] static std::optional<AstLiteralExpr::Value> binary(TokenKind op, const TypeRoot* type, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs);
+        [[nodiscard]] static AstLiteralExpr::Value cast(const TypeRoot* type, const TypeRoot* from, const AstLiteralExpr::Value& value);
+        /// Signed +, - or * does not fit the type. Negation is 0 - value
+        [[nodiscard]] static bool overflows(TokenKind op, const TypeRoot* type, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs);
+
     private:
+        AstExpr* visitIdentExpr(const AstIdentExpr& ast);
         AstExpr* visitUnaryExpr(const AstUnaryExpr& ast);
-        AstLiteralExpr::Value unary(TokenKind op, const AstLiteralExpr& ast);
         AstExpr* visitIfExpr(AstIfExpr& ast);
         AstExpr* optimizeIifToCast(AstIfExpr& ast);
         AstExpr* visitBinaryExpr(AstBinaryExpr& ast);
         AstExpr* visitCastExpr(const AstCastExpr& ast);
-        AstLiteralExpr::Value cast(const TypeRoot* type, const AstLiteralExpr& ast);
+        AstExpr* visitBoundExpr(const AstBoundExpr& ast);
+        [[nodiscard]] bool trapsOverflow(TokenKind op, const TypeRoot* type, const AstLiteralExpr::Value& lhs, const AstLiteralExpr::Value& rhs) const;
 
         Context& m_context;
     };
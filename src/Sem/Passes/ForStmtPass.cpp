@@ -11,15 +11,14 @@ using namespace Sem;
 
 ForStmtPass::ForStmtPass(SemanticAnalyzer& sem, AstForStmt& ast)
 : m_sem{ sem }, m_ast{ ast } {
-    auto* current = sem.getSymbolTable();
-    m_ast.symbolTable = sem.getContext().create<SymbolTable>(current);
-    sem.setSymbolTable(m_ast.symbolTable);
+    m_ast.symbolTable = sem.getContext().create<SymbolTable>();
+    sem.getScopes().enter(m_ast.symbolTable);
 
     ceclare();
     analyze();
     determineForDirection();
 
-    sem.setSymbolTable(current);
+    sem.getScopes().leave();
 }
 
 void ForStmtPass::ceclare() {
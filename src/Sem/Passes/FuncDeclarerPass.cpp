@@ -56,6 +56,8 @@ void FuncDeclarerPass::visitFuncDecl(AstFuncDecl& ast, bool external) {
         }
     }
 
+    checkAttributes(ast);
+
     if (symbol->name() == "MAIN" && symbol->alias().empty()) {
         symbol->setAlias("main");
         symbol->setExternal(true);
@@ -65,7 +67,7 @@ void FuncDeclarerPass::visitFuncDecl(AstFuncDecl& ast, bool external) {
 
     // parameters
     std::vector<const TypeRoot*> paramTypes;
-    ast.symbolTable = m_context.create<SymbolTable>(m_table);
+    ast.symbolTable = m_context.create<SymbolTable>();
     if (ast.params != nullptr) {
         paramTypes.reserve(ast.params->params.size());
         RESTORE_ON_EXIT(m_table);
@@ -91,6 +93,38 @@ void FuncDeclarerPass::visitFuncDecl(AstFuncDecl& ast, bool external) {
     ast.symbol = symbol;
 }
 
+/**
+ * Performance attributes are flags without arguments. Inlining and
+ * fast-math need the function body, layout hints apply to declarations too
+ */
+void FuncDeclarerPass::checkAttributes(const AstFuncDecl& ast) {
+    const auto* attribs = ast.attributes;
+    if (attribs == nullptr) {
+        return;
+    }
+
+    static constexpr std::array flags{ "INLINE", "NOINLINE", "HOT", "COLD", "FLATTEN", "FASTMATH" };
+    for (const auto* attr : attribs->attribs) {
+        const auto& name = attr->identExpr->name;
+        if (!llvm::is_contained(flags, name)) {
+            continue;
+        }
+        if (attr->args != nullptr) {
+            fatalError("Attribute "_t + name + " does not take arguments");
+        }
+        if (!ast.hasImpl && (name == "INLINE" || name == "FLATTEN" || name == "FASTMATH")) {
+            fatalError("Attribute "_t + name + " requires a FUNCTION or SUB body");
+        }
+    }
+
+    if (attribs->exists("INLINE") && attribs->exists("NOINLINE")) {
+        fatalError("Attributes INLINE and NOINLINE are mutually exclusive");
+    }
+    if (attribs->exists("HOT") && attribs->exists("COLD")) {
+        fatalError("Attributes HOT and COLD are mutually exclusive");
+    }
+}
+
 void FuncDeclarerPass::visitFuncParamDecl(AstFuncParamDecl& ast) {
     auto* symbol = createParamSymbol(ast);
 
@@ -102,7 +136,7 @@ void FuncDeclarerPass::visitFuncParamDecl(AstFuncParamDecl& ast) {
 
 Symbol* FuncDeclarerPass::createParamSymbol(AstFuncParamDecl& ast) {
     const auto& name = ast.name;
-    if (m_table->find(name, false) != nullptr) {
+    if (m_table->exists(name)) {
         fatalError("Redefinition of "_t + name);
     }
     auto* symbol = m_table->insert(m_context, name);
@@ -37,6 +37,7 @@ namespace Sem {
     private:
         void visit(lbc::AstStmtList& ast);
         void visitFuncDecl(AstFuncDecl& ast, bool external);
+        static void checkAttributes(const AstFuncDecl& ast);
         void visitFuncParamDecl(AstFuncParamDecl& ast);
         [[nodiscard]] Symbol* createParamSymbol(AstFuncParamDecl& ast);
 
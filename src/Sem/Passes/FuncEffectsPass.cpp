@@ -0,0 +1,359 @@
+//
+// Created by agent on 18/10/2026.
+//
+#include "FuncEffectsPass.hpp"
+#include "Type/Type.hpp"
+using namespace lbc;
+using namespace Sem;
+
+void FuncEffectsPass::visit(AstModule& ast) {
+    collect(*ast.stmtList);
+
+    // effects only grow, so iterating until nothing changes
+    // also settles mutually recursive functions
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (auto* func : m_functions) {
+            auto& summary = m_summaries.find(func->decl->symbol)->second;
+            auto before = summary.effects;
+
+            m_summary = &summary;
+            scan(*func->stmtList);
+            if (summary.paramsModified) {
+                summary.effects.argMemOnly = false;
+            }
+
+            changed = changed
+                || before.readsMemory != summary.effects.readsMemory
+                || before.writesMemory != summary.effects.writesMemory
+                || before.argMemOnly != summary.effects.argMemOnly;
+        }
+    }
+    m_summary = nullptr;
+
+    for (auto* func : m_functions) {
+        auto* symbol = func->decl->symbol;
+        auto effects = m_summaries.find(symbol)->second.effects;
+        effects.willReturn = willReturn(symbol);
+        symbol->setFuncEffects(effects);
+    }
+}
+
+void FuncEffectsPass::collect(AstStmtList& ast) {
+    for (auto* stmt : ast.stmts) {
+        if (auto* func = dyn_cast<AstFuncStmt>(stmt)) {
+            auto& summary = m_summaries[func->decl->symbol];
+            if (func->decl->params != nullptr) {
+                for (const auto* param : func->decl->params->params) {
+                    summary.params.insert(param->symbol);
+                }
+            }
+            m_functions.push_back(func);
+        } else if (auto* import = dyn_cast<AstImport>(stmt)) {
+            if (import->module) {
+                collect(*import->module->stmtList);
+            }
+        }
+    }
+}
+
+/**
+ * Recursion is never proven to terminate, so a function is assumed
+ * not to return while its callees are checked
+ */
+bool FuncEffectsPass::willReturn(const Symbol* symbol) {
+    if (auto iter = m_willReturn.find(symbol); iter != m_willReturn.end()) {
+        return iter->second;
+    }
+    auto iter = m_summaries.find(symbol);
+    if (iter == m_summaries.end()) {
+        return false;
+    }
+    const auto& summary = iter->second;
+
+    m_willReturn[symbol] = false;
+    bool result = !summary.hasLoop && !summary.callsUnknown
+        && std::all_of(summary.callees.begin(), summary.callees.end(), [&](const Symbol* callee) {
+               return willReturn(callee);
+           });
+    m_willReturn[symbol] = result;
+    return result;
+}
+
+//----------------------------------------
+// Statements
+//----------------------------------------
+
+void FuncEffectsPass::scan(AstStmt& ast) {
+    switch (ast.kind) {
+    case AstKind::StmtList:
+        for (auto* stmt : static_cast<AstStmtList&>(ast).stmts) {
+            scan(*stmt);
+        }
+        return;
+    case AstKind::ExprStmt:
+        return scan(*static_cast<AstExprStmt&>(ast).expr);
+    case AstKind::VarDecl: {
+        auto& decl = static_cast<AstVarDecl&>(ast);
+        m_summary->locals.insert(decl.symbol);
+        // dynamic arrays are allocated by the runtime
+        if (decl.symbol->type()->isDynamicArray()) {
+            unknown();
+        }
+        if (decl.expr != nullptr) {
+            scan(*decl.expr);
+        }
+        return;
+    }
+    case AstKind::ConstDecl:
+    case AstKind::ContinuationStmt:
+        return;
+    case AstKind::ReturnStmt:
+        if (auto* expr = static_cast<AstReturnStmt&>(ast).expr) {
+            scan(*expr);
+        }
+        return;
+    case AstKind::IfStmt:
+        for (auto& block : static_cast<AstIfStmt&>(ast).blocks) {
+            scan(block.decls);
+            if (block.expr != nullptr) {
+                scan(*block.expr);
+            }
+            scan(*block.stmt);
+        }
+        return;
+    case AstKind::ForStmt: {
+        auto& loop = static_cast<AstForStmt&>(ast);
+        m_summary->hasLoop = true;
+        scan(loop.decls);
+        scan(*loop.iterator);
+        scan(*loop.limit);
+        if (loop.step != nullptr) {
+            scan(*loop.step);
+        }
+        return scan(*loop.stmt);
+    }
+    case AstKind::DoLoopStmt: {
+        auto& loop = static_cast<AstDoLoopStmt&>(ast);
+        m_summary->hasLoop = true;
+        scan(loop.decls);
+        if (loop.expr != nullptr) {
+            scan(*loop.expr);
+        }
+        return scan(*loop.stmt);
+    }
+    default:
+        return unknown();
+    }
+}
+
+void FuncEffectsPass::scan(const std::vector<AstVarDecl*>& decls) {
+    for (auto* decl : decls) {
+        scan(*decl);
+    }
+}
+
+//----------------------------------------
+// Expressions
+//----------------------------------------
+
+void FuncEffectsPass::scan(AstExpr& ast) {
+    switch (ast.kind) {
+    case AstKind::LiteralExpr:
+        return;
+    case AstKind::IdentExpr:
+    case AstKind::MemberAccess:
+    case AstKind::IndexExpr:
+    case AstKind::Dereference:
+        return access(location(ast), false);
+    case AstKind::AddressOf: {
+        auto* expr = static_cast<AstAddressOf&>(ast).expr;
+        if (auto* ident = dyn_cast<AstIdentExpr>(expr); ident != nullptr && m_summary->params.contains(ident->symbol)) {
+            m_summary->paramsModified = true;
+        }
+        (void)location(*expr);
+        return;
+    }
+    case AstKind::AssignExpr: {
+        auto& assign = static_cast<AstAssignExpr&>(ast);
+        scan(*assign.rhs);
+        if (auto* ident = dyn_cast<AstIdentExpr>(assign.lhs); ident != nullptr && m_summary->params.contains(ident->symbol)) {
+            m_summary->paramsModified = true;
+        }
+        return access(location(*assign.lhs), true);
+    }
+    case AstKind::CallExpr:
+        return call(static_cast<AstCallExpr&>(ast));
+    case AstKind::UnaryExpr:
+        return scan(*static_cast<AstUnaryExpr&>(ast).expr);
+    case AstKind::BinaryExpr: {
+        auto& binary = static_cast<AstBinaryExpr&>(ast);
+        scan(*binary.lhs);
+        return scan(*binary.rhs);
+    }
+    case AstKind::CastExpr:
+        return scan(*static_cast<AstCastExpr&>(ast).expr);
+    case AstKind::IfExpr: {
+        auto& iif = static_cast<AstIfExpr&>(ast);
+        scan(*iif.expr);
+        scan(*iif.trueExpr);
+        return scan(*iif.falseExpr);
+    }
+    case AstKind::ArrayExpr:
+        for (auto* element : static_cast<AstArrayExpr&>(ast).elements) {
+            scan(*element);
+        }
+        return;
+    case AstKind::BoundExpr:
+        return scan(*static_cast<AstBoundExpr&>(ast).expr);
+    case AstKind::IntrinsicExpr: {
+        auto& intrinsic = static_cast<AstIntrinsicExpr&>(ast);
+        // llvm.prefetch is modelled as reading the memory it points to
+        if (intrinsic.intrinsic == IntrinsicKind::Prefetch) {
+            return access(pointee(*intrinsic.args->exprs[0]), false);
+        }
+        for (auto* arg : intrinsic.args->exprs) {
+            scan(*arg);
+        }
+        return;
+    }
+    case AstKind::ShuffleExpr: {
+        auto& shuffle = static_cast<AstShuffleExpr&>(ast);
+        scan(*shuffle.lhs);
+        if (shuffle.rhs != nullptr) {
+            scan(*shuffle.rhs);
+        }
+        return;
+    }
+    default:
+        return unknown();
+    }
+}
+
+/**
+ * Callee accessing only its pointer arguments touches caller's
+ * arguments too, when all pointers passed to it come from them
+ */
+void FuncEffectsPass::call(AstCallExpr& ast) {
+    const auto& args = ast.args->exprs;
+    for (auto* arg : args) {
+        scan(*arg);
+    }
+
+    auto* ident = dyn_cast<AstIdentExpr>(ast.callable);
+    if (ident == nullptr || !ident->symbol->getFlags().callable) {
+        scan(*ast.callable);
+        return unknown();
+    }
+
+    auto iter = m_summaries.find(ident->symbol);
+    if (iter == m_summaries.end()) {
+        return unknown();
+    }
+    m_summary->callees.insert(ident->symbol);
+
+    const auto& effects = iter->second.effects;
+    if (!effects.readsMemory && !effects.writesMemory) {
+        return;
+    }
+
+    auto loc = Location::Other;
+    if (effects.argMemOnly) {
+        auto viaArgs = std::all_of(args.begin(), args.end(), [&](const AstExpr* arg) {
+            return !arg->type->isPointer() || isArgumentDerived(*arg);
+        });
+        if (viaArgs) {
+            loc = Location::Argument;
+        }
+    }
+    if (effects.readsMemory) {
+        access(loc, false);
+    }
+    if (effects.writesMemory) {
+        access(loc, true);
+    }
+}
+
+/**
+ * Where the memory designated by the expression lives. Subexpressions
+ * evaluated to reach it are scanned as reads
+ */
+FuncEffectsPass::Location FuncEffectsPass::location(AstExpr& ast) {
+    switch (ast.kind) {
+    case AstKind::IdentExpr: {
+        const auto* symbol = static_cast<AstIdentExpr&>(ast).symbol;
+        if (symbol->getFlags().callable) {
+            return Location::None;
+        }
+        if (m_summary->locals.contains(symbol) || m_summary->params.contains(symbol)) {
+            return Location::Local;
+        }
+        return Location::Other;
+    }
+    case AstKind::MemberAccess: {
+        auto* lhs = static_cast<AstMemberAccess&>(ast).lhs;
+        if (lhs->type->isPointer()) {
+            return pointee(*lhs);
+        }
+        return location(*lhs);
+    }
+    case AstKind::IndexExpr: {
+        auto& index = static_cast<AstIndexExpr&>(ast);
+        scan(*index.index);
+        if (index.expr->type->isPointer()) {
+            return pointee(*index.expr);
+        }
+        if (index.expr->type->isDynamicArray()) {
+            scan(*index.expr);
+            return Location::Other;
+        }
+        return location(*index.expr);
+    }
+    case AstKind::Dereference:
+        return pointee(*static_cast<AstDereference&>(ast).expr);
+    default:
+        scan(ast);
+        return Location::None;
+    }
+}
+
+FuncEffectsPass::Location FuncEffectsPass::pointee(AstExpr& ast) {
+    scan(ast);
+    return isArgumentDerived(ast) ? Location::Argument : Location::Other;
+}
+
+bool FuncEffectsPass::isArgumentDerived(const AstExpr& ast) const {
+    if (const auto* ident = dyn_cast<AstIdentExpr>(&ast)) {
+        return m_summary->params.contains(ident->symbol) && ident->type->isPointer();
+    }
+    if (const auto* binary = dyn_cast<AstBinaryExpr>(&ast); binary != nullptr && binary->type->isPointer()) {
+        return isArgumentDerived(binary->lhs->type->isPointer() ? *binary->lhs : *binary->rhs);
+    }
+    return false;
+}
+
+void FuncEffectsPass::access(Location location, bool write) noexcept {
+    switch (location) {
+    case Location::None:
+    case Location::Local:
+        return;
+    case Location::Argument:
+        break;
+    case Location::Other:
+        m_summary->effects.argMemOnly = false;
+        break;
+    }
+    if (write) {
+        m_summary->effects.writesMemory = true;
+    } else {
+        m_summary->effects.readsMemory = true;
+    }
+}
+
+void FuncEffectsPass::unknown() noexcept {
+    m_summary->effects.readsMemory = true;
+    m_summary->effects.writesMemory = true;
+    m_summary->effects.argMemOnly = false;
+    m_summary->callsUnknown = true;
+}
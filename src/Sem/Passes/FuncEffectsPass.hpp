@@ -0,0 +1,69 @@
+//
+// Created by agent on 18/10/2026.
+//
+#pragma once
+#include "Ast/Ast.hpp"
+#include "Symbol/Symbol.hpp"
+
+namespace lbc {
+
+namespace Sem {
+
+    /**
+     * Infer memory and control effects of FUNCTIONs and SUBs.
+     *
+     * Runs over the analyzed module. A function is readnone when it only
+     * touches its locals, readonly when it does not write memory visible
+     * to the caller and argmemonly when all memory it accesses is reached
+     * through its pointer parameters. Calls propagate effects of the callee,
+     * which are iterated to a fixed point for recursive functions.
+     * Functions without loops that only call such functions will return.
+     */
+    class FuncEffectsPass final {
+    public:
+        NO_COPY_AND_MOVE(FuncEffectsPass)
+
+        FuncEffectsPass() noexcept = default;
+        ~FuncEffectsPass() noexcept = default;
+
+        void visit(AstModule& ast);
+
+    private:
+        enum class Location {
+            None,
+            Local,
+            Argument,
+            Other
+        };
+
+        struct Summary final {
+            FuncEffects effects{ false, false, true, false };
+            llvm::SmallPtrSet<const Symbol*, 8> locals;
+            llvm::SmallPtrSet<const Symbol*, 4> params;
+            llvm::SmallPtrSet<const Symbol*, 4> callees;
+            bool hasLoop = false;
+            bool callsUnknown = false;
+            bool paramsModified = false;
+        };
+
+        void collect(AstStmtList& ast);
+        [[nodiscard]] bool willReturn(const Symbol* symbol);
+
+        void scan(AstStmt& ast);
+        void scan(const std::vector<AstVarDecl*>& decls);
+        void scan(AstExpr& ast);
+        void call(AstCallExpr& ast);
+        [[nodiscard]] Location location(AstExpr& ast);
+        [[nodiscard]] Location pointee(AstExpr& ast);
+        [[nodiscard]] bool isArgumentDerived(const AstExpr& ast) const;
+        void access(Location location, bool write) noexcept;
+        void unknown() noexcept;
+
+        std::vector<AstFuncStmt*> m_functions;
+        llvm::DenseMap<const Symbol*, Summary> m_summaries;
+        llvm::DenseMap<const Symbol*, bool> m_willReturn;
+        Summary* m_summary = nullptr;
+    };
+
+} // namespace Sem
+} // namespace lbc
@@ -0,0 +1,659 @@
+//
+// Created by agent on 18/10/2026.
+//
+#include "FuncEvaluatorPass.hpp"
+#include "ConstantFoldingPass.hpp"
+#include "Driver/CompileOptions.hpp"
+#include "Driver/Context.hpp"
+#include "Sem/SemanticAnalyzer.hpp"
+#include "Symbol/Symbol.hpp"
+#include "Symbol/SymbolTable.hpp"
+#include "Type/Type.hpp"
+using namespace lbc;
+using namespace Sem;
+
+namespace {
+/**
+ * Collect identifiers and local declarations used in a function body.
+ * Fails on any construct that the evaluator does not support.
+ */
+class PurityScanner final {
+public:
+    bool scan(AstStmt& ast) {
+        switch (ast.kind) {
+        case AstKind::StmtList:
+            return std::all_of(
+                static_cast<AstStmtList&>(ast).stmts.begin(),
+                static_cast<AstStmtList&>(ast).stmts.end(),
+                [&](auto* stmt) { return scan(*stmt); });
+        case AstKind::ExprStmt:
+            return scan(*static_cast<AstExprStmt&>(ast).expr);
+        case AstKind::VarDecl: {
+            auto& decl = static_cast<AstVarDecl&>(ast);
+            locals.insert(decl.name);
+            return decl.expr == nullptr || scan(*decl.expr);
+        }
+        case AstKind::ConstDecl: {
+            auto& decl = static_cast<AstConstDecl&>(ast);
+            locals.insert(decl.name);
+            return scan(*decl.expr);
+        }
+        case AstKind::ReturnStmt: {
+            auto* expr = static_cast<AstReturnStmt&>(ast).expr;
+            return expr == nullptr || scan(*expr);
+        }
+        case AstKind::IfStmt:
+            for (auto& block : static_cast<AstIfStmt&>(ast).blocks) {
+                if (!scan(block.decls) || (block.expr != nullptr && !scan(*block.expr)) || !scan(*block.stmt)) {
+                    return false;
+                }
+            }
+            return true;
+        case AstKind::ForStmt: {
+            auto& loop = static_cast<AstForStmt&>(ast);
+            return scan(loop.decls)
+                && scan(*loop.iterator)
+                && scan(*loop.limit)
+                && (loop.step == nullptr || scan(*loop.step))
+                && scan(*loop.stmt);
+        }
+        case AstKind::DoLoopStmt: {
+            auto& loop = static_cast<AstDoLoopStmt&>(ast);
+            return scan(loop.decls)
+                && (loop.expr == nullptr || scan(*loop.expr))
+                && scan(*loop.stmt);
+        }
+        case AstKind::ContinuationStmt:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    bool scan(const std::vector<AstVarDecl*>& decls) {
+        return std::all_of(decls.begin(), decls.end(), [&](auto* decl) { return scan(*decl); });
+    }
+
+    bool scan(AstExpr& ast) {
+        switch (ast.kind) {
+        case AstKind::LiteralExpr:
+            return true;
+        case AstKind::IdentExpr:
+            idents.push_back(static_cast<AstIdentExpr&>(ast).name);
+            return true;
+        case AstKind::CallExpr: {
+            auto& call = static_cast<AstCallExpr&>(ast);
+            if (!isa<AstIdentExpr>(call.callable) || !scan(*call.callable)) {
+                return false;
+            }
+            const auto& args = call.args->exprs;
+            return std::all_of(args.begin(), args.end(), [&](auto* arg) { return scan(*arg); });
+        }
+        case AstKind::AssignExpr: {
+            auto& assign = static_cast<AstAssignExpr&>(ast);
+            return isa<AstIdentExpr>(assign.lhs) && scan(*assign.lhs) && scan(*assign.rhs);
+        }
+        case AstKind::UnaryExpr:
+            return scan(*static_cast<AstUnaryExpr&>(ast).expr);
+        case AstKind::BinaryExpr: {
+            auto& binary = static_cast<AstBinaryExpr&>(ast);
+            return scan(*binary.lhs) && scan(*binary.rhs);
+        }
+        case AstKind::CastExpr:
+            return scan(*static_cast<AstCastExpr&>(ast).expr);
+        case AstKind::IfExpr: {
+            auto& iif = static_cast<AstIfExpr&>(ast);
+            return scan(*iif.expr) && scan(*iif.trueExpr) && scan(*iif.falseExpr);
+        }
+        default:
+            return false;
+        }
+    }
+
+    llvm::StringSet<> locals;
+    std::vector<StringRef> idents;
+};
+} // namespace
+
+void FuncEvaluatorPass::declare(AstStmtList& ast) {
+    for (auto* stmt : ast.stmts) {
+        if (auto* func = dyn_cast<AstFuncStmt>(stmt)) {
+            m_functions.try_emplace(func->decl->symbol, func);
+        } else if (auto* import = dyn_cast<AstImport>(stmt)) {
+            if (import->module) {
+                declare(*import->module->stmtList);
+            }
+        }
+    }
+}
+
+void FuncEvaluatorPass::fold(AstExpr*& ast) {
+    auto* callExpr = dyn_cast<AstCallExpr>(ast);
+    if (callExpr == nullptr || !isEvaluable(callExpr->type)) {
+        return;
+    }
+
+    auto* ident = dyn_cast<AstIdentExpr>(callExpr->callable);
+    if (ident == nullptr) {
+        return;
+    }
+    auto iter = m_functions.find(ident->symbol);
+    if (iter == m_functions.end()) {
+        return;
+    }
+
+    std::vector<Value> args;
+    args.reserve(callExpr->args->exprs.size());
+    for (auto* arg : callExpr->args->exprs) {
+        auto* literal = dyn_cast<AstLiteralExpr>(arg);
+        if (literal == nullptr) {
+            return;
+        }
+        args.emplace_back(literal->value);
+    }
+
+    // analyzing a function body on demand can fold nested calls
+    RESTORE_ON_EXIT(m_steps);
+    RESTORE_ON_EXIT(m_failed);
+    m_steps = 0;
+    m_failed = false;
+    auto result = call(*iter->second, std::move(args));
+    if (!result) {
+        return;
+    }
+
+    auto* repl = m_sem.getContext().create<AstLiteralExpr>(ast->range, *result);
+    repl->type = ast->type;
+    ast = repl;
+}
+
+//----------------------------------------
+// Functions
+//----------------------------------------
+
+/**
+ * Function body must be pure and analyzed before it can be evaluated
+ */
+bool FuncEvaluatorPass::prepare(AstFuncStmt& ast) {
+    return isPure(ast) && m_sem.ensureAnalyzed(ast);
+}
+
+/**
+ * Check syntactically, before analysis, that function only refers to
+ * its parameters, locals, constants and other functions
+ */
+bool FuncEvaluatorPass::isPure(AstFuncStmt& ast) {
+    if (auto iter = m_pure.find(&ast); iter != m_pure.end()) {
+        return iter->second;
+    }
+
+    const auto check = [&]() {
+        PurityScanner scanner;
+        if (ast.decl->params != nullptr) {
+            for (const auto* param : ast.decl->params->params) {
+                if (!isEvaluable(param->symbol->type())) {
+                    return false;
+                }
+                scanner.locals.insert(param->name);
+            }
+        }
+        if (!scanner.scan(*ast.stmtList)) {
+            return false;
+        }
+        return std::all_of(scanner.idents.begin(), scanner.idents.end(), [&](StringRef name) {
+            if (scanner.locals.contains(name)) {
+                return true;
+            }
+            const auto* symbol = ast.decl->symbolTable->find(name);
+            if (symbol == nullptr) {
+                symbol = m_sem.getRootSymbolTable()->find(name);
+            }
+            return symbol != nullptr
+                && (symbol->getFlags().callable || symbol->getConstantValue() != nullptr);
+        });
+    };
+
+    auto pure = check();
+    m_pure[&ast] = pure;
+    return pure;
+}
+
+std::optional<FuncEvaluatorPass::Value> FuncEvaluatorPass::call(AstFuncStmt& ast, std::vector<Value> args) {
+    const auto* type = llvm::cast<TypeFunction>(ast.decl->symbol->type());
+    if (m_depth >= MAX_CALL_DEPTH || !isEvaluable(type->getReturn()) || !prepare(ast)) {
+        return std::nullopt;
+    }
+
+    Frame frame;
+    if (ast.decl->params != nullptr) {
+        const auto& params = ast.decl->params->params;
+        for (size_t index = 0; index < params.size(); index++) {
+            frame[params[index]->symbol] = args[index];
+        }
+    }
+
+    RESTORE_ON_EXIT(m_frame);
+    m_frame = &frame;
+    m_depth++;
+    exec(*ast.stmtList);
+    m_depth--;
+
+    if (m_failed || m_flow != Flow::Return) {
+        fail();
+        return std::nullopt;
+    }
+    m_flow = Flow::Normal;
+    return m_returnValue;
+}
+
+//----------------------------------------
+// Statements
+//----------------------------------------
+
+void FuncEvaluatorPass::exec(AstStmt& ast) {
+    if (!step()) {
+        return;
+    }
+
+    switch (ast.kind) {
+    case AstKind::StmtList:
+        for (auto* stmt : static_cast<AstStmtList&>(ast).stmts) {
+            exec(*stmt);
+            if (m_failed || m_flow != Flow::Normal) {
+                return;
+            }
+        }
+        return;
+    case AstKind::ExprStmt:
+        if (!eval(*static_cast<AstExprStmt&>(ast).expr)) {
+            fail();
+        }
+        return;
+    case AstKind::VarDecl:
+        return declareVar(static_cast<AstVarDecl&>(ast));
+    case AstKind::ConstDecl:
+        return;
+    case AstKind::ReturnStmt: {
+        auto* expr = static_cast<AstReturnStmt&>(ast).expr;
+        if (expr == nullptr) {
+            return fail();
+        }
+        if (auto value = eval(*expr)) {
+            m_returnValue = *value;
+            m_flow = Flow::Return;
+            return;
+        }
+        return fail();
+    }
+    case AstKind::IfStmt:
+        return execIf(static_cast<AstIfStmt&>(ast));
+    case AstKind::ForStmt:
+        return execFor(static_cast<AstForStmt&>(ast));
+    case AstKind::DoLoopStmt:
+        return execDoLoop(static_cast<AstDoLoopStmt&>(ast));
+    case AstKind::ContinuationStmt:
+        return execContinuation(static_cast<AstContinuationStmt&>(ast));
+    default:
+        return fail();
+    }
+}
+
+void FuncEvaluatorPass::declareVar(AstVarDecl& ast) {
+    const auto* type = ast.symbol->type();
+    if (!isEvaluable(type)) {
+        return fail();
+    }
+
+    if (ast.expr != nullptr) {
+        if (auto value = eval(*ast.expr)) {
+            (*m_frame)[ast.symbol] = *value;
+            return;
+        }
+        return fail();
+    }
+
+    if (type->isBoolean()) {
+        (*m_frame)[ast.symbol] = false;
+    } else if (type->isIntegral()) {
+        (*m_frame)[ast.symbol] = uint64_t{ 0 };
+    } else {
+        (*m_frame)[ast.symbol] = 0.0;
+    }
+}
+
+void FuncEvaluatorPass::execIf(AstIfStmt& ast) {
+    for (auto& block : ast.blocks) {
+        for (auto* decl : block.decls) {
+            declareVar(*decl);
+        }
+        if (block.expr != nullptr) {
+            auto cond = evalCondition(*block.expr);
+            if (!cond) {
+                return fail();
+            }
+            if (!*cond) {
+                continue;
+            }
+        }
+        return exec(*block.stmt);
+    }
+}
+
+/**
+ * Mirrors Gen::ForStmtBuilder: iterator moves towards the limit by
+ * the absolute step value, and negative steps are only valid when
+ * counting down.
+ */
+void FuncEvaluatorPass::execFor(AstForStmt& ast) {
+    if (ast.direction == AstForStmt::Direction::Skip) {
+        return;
+    }
+
+    for (auto* decl : ast.decls) {
+        declareVar(*decl);
+    }
+    declareVar(*ast.iterator);
+    if (m_failed) {
+        return;
+    }
+
+    const auto* type = ast.iterator->symbol->type();
+    auto limit = eval(*ast.limit);
+    if (!limit) {
+        return fail();
+    }
+
+    bool isDecr = ast.direction == AstForStmt::Direction::Decrement;
+    if (ast.direction == AstForStmt::Direction::Unknown) {
+        auto value = ConstantFoldingPass::binary(TokenKind::LessThan, type, *limit, (*m_frame)[ast.iterator->symbol]);
+        isDecr = std::get<bool>(*value);
+    }
+
+    Value stepValue = type->isIntegral() ? Value{ uint64_t{ 1 } } : Value{ 1.0 };
+    if (ast.step != nullptr) {
+        const auto* stepType = ast.step->type;
+        auto value = eval(*ast.step);
+        if (!value) {
+            return fail();
+        }
+        auto zero = ConstantFoldingPass::cast(stepType, type, Value{ uint64_t{ 0 } });
+        if (type->isFloatingPoint()) {
+            zero = ConstantFoldingPass::cast(stepType, type, Value{ 0.0 });
+        }
+        bool isNegative = std::get<bool>(*ConstantFoldingPass::binary(TokenKind::LessThan, stepType, *value, zero));
+        if (isNegative != isDecr) {
+            return;
+        }
+        if (isNegative) {
+            value = ConstantFoldingPass::cast(stepType, stepType, ConstantFoldingPass::unary(TokenKind::Negate, *value));
+        }
+        stepValue = ConstantFoldingPass::cast(type, stepType, *value);
+    }
+
+    auto loop = ++m_loopId;
+    m_loops.push(ControlFlowStatement::For, loop);
+    while (step()) {
+        auto& iter = (*m_frame)[ast.iterator->symbol];
+        auto cond = isDecr
+            ? ConstantFoldingPass::binary(TokenKind::LessOrEqual, type, *limit, iter)
+            : ConstantFoldingPass::binary(TokenKind::LessOrEqual, type, iter, *limit);
+        if (!std::get<bool>(*cond)) {
+            break;
+        }
+
+        exec(*ast.stmt);
+        if (shouldBreak(loop)) {
+            break;
+        }
+
+        auto op = isDecr ? TokenKind::Minus : TokenKind::Plus;
+        if (trapsOverflow(op, type, (*m_frame)[ast.iterator->symbol], stepValue)) {
+            fail();
+            break;
+        }
+        auto next = ConstantFoldingPass::binary(op, type, (*m_frame)[ast.iterator->symbol], stepValue);
+        (*m_frame)[ast.iterator->symbol] = *next;
+    }
+    m_loops.pop();
+}
+
+void FuncEvaluatorPass::execDoLoop(AstDoLoopStmt& ast) {
+    using Condition = AstDoLoopStmt::Condition;
+
+    for (auto* decl : ast.decls) {
+        declareVar(*decl);
+    }
+
+    const auto isDone = [&]() -> std::optional<bool> {
+        auto cond = evalCondition(*ast.expr);
+        if (!cond) {
+            return std::nullopt;
+        }
+        bool isUntil = ast.condition == Condition::PreUntil || ast.condition == Condition::PostUntil;
+        return isUntil == *cond;
+    };
+
+    auto loop = ++m_loopId;
+    m_loops.push(ControlFlowStatement::Do, loop);
+    while (step()) {
+        if (ast.condition == Condition::PreWhile || ast.condition == Condition::PreUntil) {
+            auto done = isDone();
+            if (!done) {
+                fail();
+            }
+            if (!done || *done) {
+                break;
+            }
+        }
+
+        exec(*ast.stmt);
+        if (shouldBreak(loop)) {
+            break;
+        }
+
+        if (ast.condition == Condition::PostWhile || ast.condition == Condition::PostUntil) {
+            auto done = isDone();
+            if (!done) {
+                fail();
+            }
+            if (!done || *done) {
+                break;
+            }
+        }
+    }
+    m_loops.pop();
+}
+
+void FuncEvaluatorPass::execContinuation(AstContinuationStmt& ast) {
+    auto iter = m_loops.find(ast.destination);
+    if (iter == m_loops.cend()) {
+        return fail();
+    }
+    m_flowTarget = iter->second;
+    m_flow = ast.action == AstContinuationStmt::Action::Continue ? Flow::Continue : Flow::Exit;
+}
+
+/**
+ * Handle control flow after executing loop body.
+ * Returns true if loop must terminate
+ */
+bool FuncEvaluatorPass::shouldBreak(unsigned loop) {
+    if (m_failed) {
+        return true;
+    }
+    switch (m_flow) {
+    case Flow::Normal:
+        return false;
+    case Flow::Continue:
+        if (m_flowTarget == loop) {
+            m_flow = Flow::Normal;
+            return false;
+        }
+        return true;
+    case Flow::Exit:
+        if (m_flowTarget == loop) {
+            m_flow = Flow::Normal;
+        }
+        return true;
+    case Flow::Return:
+        return true;
+    }
+    llvm_unreachable("Invalid flow");
+}
+
+//----------------------------------------
+// Expressions
+//----------------------------------------
+
+std::optional<FuncEvaluatorPass::Value> FuncEvaluatorPass::eval(AstExpr& ast) {
+    if (!step()) {
+        return std::nullopt;
+    }
+
+    switch (ast.kind) {
+    case AstKind::LiteralExpr:
+        return static_cast<AstLiteralExpr&>(ast).value;
+    case AstKind::IdentExpr: {
+        auto iter = m_frame->find(static_cast<AstIdentExpr&>(ast).symbol);
+        if (iter == m_frame->end()) {
+            return std::nullopt;
+        }
+        return iter->second;
+    }
+    case AstKind::AssignExpr: {
+        auto& assign = static_cast<AstAssignExpr&>(ast);
+        auto* ident = dyn_cast<AstIdentExpr>(assign.lhs);
+        if (ident == nullptr || m_frame->count(ident->symbol) == 0) {
+            return std::nullopt;
+        }
+        auto value = eval(*assign.rhs);
+        if (value) {
+            (*m_frame)[ident->symbol] = *value;
+        }
+        return value;
+    }
+    case AstKind::CallExpr:
+        return evalCall(static_cast<AstCallExpr&>(ast));
+    case AstKind::UnaryExpr: {
+        auto& unary = static_cast<AstUnaryExpr&>(ast);
+        auto value = eval(*unary.expr);
+        if (!value) {
+            return std::nullopt;
+        }
+        if (unary.tokenKind == TokenKind::Negate && trapsOverflow(TokenKind::Minus, unary.type, Value{ uint64_t{ 0 } }, *value)) {
+            return std::nullopt;
+        }
+        // wrap negated values around the width of the type
+        return ConstantFoldingPass::cast(
+            unary.type,
+            unary.type,
+            ConstantFoldingPass::unary(unary.tokenKind, *value));
+    }
+    case AstKind::BinaryExpr:
+        return evalBinary(static_cast<AstBinaryExpr&>(ast));
+    case AstKind::CastExpr: {
+        auto& cast = static_cast<AstCastExpr&>(ast);
+        if (!isEvaluable(cast.type)) {
+            return std::nullopt;
+        }
+        auto value = eval(*cast.expr);
+        if (!value) {
+            return std::nullopt;
+        }
+        return ConstantFoldingPass::cast(cast.type, cast.expr->type, *value);
+    }
+    case AstKind::IfExpr: {
+        auto& iif = static_cast<AstIfExpr&>(ast);
+        auto cond = evalCondition(*iif.expr);
+        if (!cond) {
+            return std::nullopt;
+        }
+        return eval(*cond ? *iif.trueExpr : *iif.falseExpr);
+    }
+    default:
+        return std::nullopt;
+    }
+}
+
+std::optional<FuncEvaluatorPass::Value> FuncEvaluatorPass::evalCall(AstCallExpr& ast) {
+    auto* ident = dyn_cast<AstIdentExpr>(ast.callable);
+    if (ident == nullptr) {
+        return std::nullopt;
+    }
+    auto iter = m_functions.find(ident->symbol);
+    if (iter == m_functions.end()) {
+        return std::nullopt;
+    }
+
+    std::vector<Value> args;
+    args.reserve(ast.args->exprs.size());
+    for (auto* arg : ast.args->exprs) {
+        auto value = eval(*arg);
+        if (!value) {
+            return std::nullopt;
+        }
+        args.emplace_back(*value);
+    }
+    return call(*iter->second, std::move(args));
+}
+
+std::optional<FuncEvaluatorPass::Value> FuncEvaluatorPass::evalBinary(AstBinaryExpr& ast) {
+    auto lhs = eval(*ast.lhs);
+    if (!lhs) {
+        return std::nullopt;
+    }
+
+    // short circuit
+    if (ast.type->isBoolean()) {
+        if (ast.tokenKind == TokenKind::LogicalAnd) {
+            return std::get<bool>(*lhs) ? eval(*ast.rhs) : lhs;
+        }
+        if (ast.tokenKind == TokenKind::LogicalOr) {
+            return std::get<bool>(*lhs) ? lhs : eval(*ast.rhs);
+        }
+    }
+
+    auto rhs = eval(*ast.rhs);
+    if (!rhs) {
+        return std::nullopt;
+    }
+    if (trapsOverflow(ast.tokenKind, ast.lhs->type, *lhs, *rhs)) {
+        return std::nullopt;
+    }
+    return ConstantFoldingPass::binary(ast.tokenKind, ast.lhs->type, *lhs, *rhs);
+}
+
+/**
+ * Evaluation wraps around like constant folding. With -ftrapv the
+ * call is left for generated code to trap at runtime
+ */
+bool FuncEvaluatorPass::trapsOverflow(TokenKind op, const TypeRoot* type, const Value& lhs, const Value& rhs) const {
+    return m_sem.getContext().getOptions().getOverflowMode() == CompileOptions::OverflowMode::Trap
+        && ConstantFoldingPass::overflows(op, type, lhs, rhs);
+}
+
+std::optional<bool> FuncEvaluatorPass::evalCondition(AstExpr& ast) {
+    if (auto value = eval(ast)) {
+        return std::get<bool>(*value);
+    }
+    return std::nullopt;
+}
+
+//----------------------------------------
+// Helpers
+//----------------------------------------
+
+bool FuncEvaluatorPass::isEvaluable(const TypeRoot* type) noexcept {
+    return type->isBoolean() || type->isNumeric();
+}
+
+bool FuncEvaluatorPass::step() {
+    if (m_failed) {
+        return false;
+    }
+    if (++m_steps > MAX_STEPS) {
+        fail();
+        return false;
+    }
+    return true;
+}
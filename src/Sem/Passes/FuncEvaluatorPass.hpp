@@ -0,0 +1,85 @@
+//
+// Created by agent on 18/10/2026.
+//
+#pragma once
+#include "Ast/Ast.hpp"
+
+namespace lbc {
+class SemanticAnalyzer;
+class TypeRoot;
+
+namespace Sem {
+
+    /**
+     * Compile time function evaluation.
+     *
+     * Calls to FUNCTIONs with all literal arguments are interpreted and
+     * replaced by the resulting literal. Only functions that work on
+     * numeric and boolean locals, constants and other such functions
+     * are evaluated. Anything else leaves the call to runtime.
+     */
+    class FuncEvaluatorPass final {
+    public:
+        NO_COPY_AND_MOVE(FuncEvaluatorPass)
+
+        static constexpr unsigned MAX_CALL_DEPTH = 64;
+        static constexpr size_t MAX_STEPS = 1'000'000;
+
+        explicit FuncEvaluatorPass(SemanticAnalyzer& sem) noexcept : m_sem{ sem } {}
+        ~FuncEvaluatorPass() noexcept = default;
+
+        /// Register function implementations in the statement list
+        void declare(AstStmtList& ast);
+
+        void fold(AstExpr*& ast);
+
+    private:
+        using Value = AstLiteralExpr::Value;
+        using Frame = llvm::DenseMap<const Symbol*, Value>;
+
+        enum class Flow {
+            Normal,
+            Continue,
+            Exit,
+            Return
+        };
+
+        [[nodiscard]] bool prepare(AstFuncStmt& ast);
+        [[nodiscard]] bool isPure(AstFuncStmt& ast);
+        [[nodiscard]] std::optional<Value> call(AstFuncStmt& ast, std::vector<Value> args);
+
+        void exec(AstStmt& ast);
+        void declareVar(AstVarDecl& ast);
+        void execIf(AstIfStmt& ast);
+        void execFor(AstForStmt& ast);
+        void execDoLoop(AstDoLoopStmt& ast);
+        void execContinuation(AstContinuationStmt& ast);
+        [[nodiscard]] bool shouldBreak(unsigned loop);
+
+        [[nodiscard]] std::optional<Value> eval(AstExpr& ast);
+        [[nodiscard]] std::optional<Value> evalCall(AstCallExpr& ast);
+        [[nodiscard]] std::optional<Value> evalBinary(AstBinaryExpr& ast);
+        [[nodiscard]] std::optional<bool> evalCondition(AstExpr& ast);
+        [[nodiscard]] bool trapsOverflow(TokenKind op, const TypeRoot* type, const Value& lhs, const Value& rhs) const;
+
+        [[nodiscard]] static bool isEvaluable(const TypeRoot* type) noexcept;
+        [[nodiscard]] bool step();
+        void fail() noexcept { m_failed = true; }
+
+        SemanticAnalyzer& m_sem;
+        llvm::DenseMap<const Symbol*, AstFuncStmt*> m_functions;
+        llvm::DenseMap<const AstFuncStmt*, bool> m_pure;
+
+        Frame* m_frame = nullptr;
+        ControlFlowStack<unsigned> m_loops;
+        unsigned m_loopId = 0;
+        unsigned m_depth = 0;
+        size_t m_steps = 0;
+        bool m_failed = false;
+        Flow m_flow = Flow::Normal;
+        unsigned m_flowTarget = 0;
+        Value m_returnValue{};
+    };
+
+} // namespace Sem
+} // namespace lbc
@@ -3,6 +3,7 @@
 //
 #include "TypeDeclPass.hpp"
 #include "Ast/Ast.hpp"
+#include "Driver/CompileOptions.hpp"
 #include "Driver/Context.hpp"
 #include "Sem/SemanticAnalyzer.hpp"
 #include "Type/Type.hpp"
@@ -14,25 +15,36 @@ TypeDeclPass::TypeDeclPass(SemanticAnalyzer& sem, AstTypeDecl& ast)
 : m_sem(sem),
   m_ast(ast),
   m_symbol{ sem.createNewSymbol(ast) } {
-    auto* current = m_sem.getSymbolTable();
-
+    const auto& options = m_sem.getContext().getOptions();
     bool packed = false;
+    bool reorder = false;
     if (ast.attributes != nullptr) {
         packed = ast.attributes->exists("PACKED");
+        reorder = ast.attributes->exists("REORDER");
+    }
+    // packed types keep their layout unless asked explicitly
+    if (!packed && options.getReorderFields()) {
+        reorder = true;
     }
 
-    ast.symbolTable = m_sem.getContext().create<SymbolTable>(current);
-    m_sem.setSymbolTable(ast.symbolTable);
+    ast.symbolTable = m_sem.getContext().create<SymbolTable>();
+    m_sem.getScopes().enter(ast.symbolTable);
     declareMembers();
-    ast.symbolTable->setParent(nullptr);
-    TypeUDT::get(m_sem.getContext(), *m_symbol, *ast.symbolTable, packed);
+    m_sem.getScopes().leave();
+    auto alignment = SemanticAnalyzer::getAlignment(ast.attributes);
+    const auto* udt = TypeUDT::get(m_sem.getContext(), *m_symbol, *ast.symbolTable, packed, alignment, reorder);
 
-    m_sem.setSymbolTable(current);
+    if (options.getWarnPadded() && udt->getPadding() > 0) {
+        warning("TYPE "_t + ast.name + " has " + llvm::Twine(udt->getPadding()) + " bytes of padding");
+    }
 }
 
 void TypeDeclPass::declareMembers() {
     for (const auto& decl : m_ast.decls->decls) {
         m_sem.visit(*decl);
+        if (decl->symbol->type()->isDynamicArray()) {
+            fatalError("Dynamic array "_t + decl->name + " cannot be a TYPE member");
+        }
         decl->symbol->setParent(m_symbol);
     }
 }
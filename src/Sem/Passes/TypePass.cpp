@@ -5,7 +5,7 @@
 #include "Ast/Ast.hpp"
 #include "Sem/SemanticAnalyzer.hpp"
 #include "Symbol/Symbol.hpp"
-#include "Symbol/SymbolTable.hpp"
+#include "Symbol/ScopedSymbolTable.hpp"
 #include "Type/Type.hpp"
 #include "Type/TypeUdt.hpp"
 
@@ -15,9 +15,8 @@ using namespace Sem;
 void TypePass::visit(AstTypeExpr& ast) {
     const TypeRoot* type = nullptr;
     if (ast.tokenKind == TokenKind::Identifier) {
-        auto* table = m_sem.getSymbolTable();
         // TODO: Support nested names
-        auto* sym = table->find(ast.ident->name);
+        auto* sym = m_sem.getScopes().find(ast.ident->name);
         if (sym == nullptr) {
             fatalError("Undefined type "_t + ast.ident->name);
         }
@@ -29,8 +28,59 @@ void TypePass::visit(AstTypeExpr& ast) {
     } else {
         type = TypeRoot::fromTokenKind(ast.tokenKind);
     }
+    if (ast.lanes != nullptr) {
+        m_sem.expression(ast.lanes);
+        auto* literal = dyn_cast<AstLiteralExpr>(ast.lanes);
+        if (literal == nullptr || !ast.lanes->type->isIntegral()) {
+            fatalError("Vector lanes must be an integral constant expression");
+        }
+        auto lanes = std::get<uint64_t>(literal->value);
+        if (ast.lanes->type->isSignedIntegral()) {
+            lanes = static_cast<uint64_t>(llvm::SignExtend64(lanes, static_cast<const TypeIntegral*>(ast.lanes->type)->getBits()));
+        }
+        if (!TypeVector::isValidLanes(lanes)) {
+            fatalError("Vector lanes must be a power of 2 up to "_t + Twine(TypeVector::MAX_LANES) + ", got " + Twine(static_cast<int64_t>(lanes)));
+        }
+        if (!type->isNumeric() && !type->isBoolean()) {
+            fatalError("Vector of non numeric type '"_t + type->asString() + "'");
+        }
+        type = TypeVector::get(m_sem.getContext(), type, static_cast<unsigned>(lanes));
+    }
     for (auto deref = 0; deref < ast.dereference; deref++) {
         type = TypePointer::get(m_sem.getContext(), type);
     }
+
+    // innermost dimension is the last one
+    for (auto iter = ast.bounds.rbegin(); iter != ast.bounds.rend(); iter++) {
+        if (iter->upper == nullptr) {
+            type = TypeDynamicArray::get(m_sem.getContext(), type);
+            continue;
+        }
+        int64_t lower = 0;
+        if (iter->lower != nullptr) {
+            lower = bound(iter->lower);
+        }
+        auto upper = bound(iter->upper);
+        if (upper < lower) {
+            fatalError("Array upper bound "_t + Twine(upper) + " is less than lower bound " + Twine(lower));
+        }
+        auto size = static_cast<uint64_t>(upper - lower) + 1;
+        type = TypeArray::get(m_sem.getContext(), type, lower, size);
+    }
     ast.type = type;
 }
+
+int64_t TypePass::bound(AstExpr*& ast) {
+    m_sem.expression(ast);
+    auto* literal = dyn_cast<AstLiteralExpr>(ast);
+    if (literal == nullptr || !ast->type->isIntegral()) {
+        fatalError("Array bound must be an integral constant expression");
+    }
+
+    auto value = std::get<uint64_t>(literal->value);
+    const auto* type = static_cast<const TypeIntegral*>(ast->type);
+    if (type->isSigned()) {
+        return llvm::SignExtend64(value, type->getBits());
+    }
+    return static_cast<int64_t>(value);
+}
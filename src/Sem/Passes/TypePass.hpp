@@ -6,6 +6,7 @@
 
 namespace lbc {
 class SemanticAnalyzer;
+struct AstExpr;
 struct AstTypeExpr;
 
 namespace Sem {
@@ -19,6 +20,8 @@ namespace Sem {
         void visit(AstTypeExpr& ast);
 
     private:
+        [[nodiscard]] int64_t bound(AstExpr*& ast);
+
         SemanticAnalyzer& m_sem;
     };
 } // namespace Sem
@@ -7,6 +7,7 @@
 #include "Lexer/Token.hpp"
 #include "Passes/ForStmtPass.hpp"
 #include "Passes/FuncDeclarerPass.hpp"
+#include "Passes/FuncEffectsPass.hpp"
 #include "Passes/TypeDeclPass.hpp"
 #include "Symbol/Symbol.hpp"
 #include "Symbol/SymbolTable.hpp"
@@ -18,17 +19,23 @@ using namespace lbc;
 SemanticAnalyzer::SemanticAnalyzer(Context& context)
 : m_context{ context },
   m_constantFolder{ context },
-  m_typePass{ *this } {}
+  m_typePass{ *this },
+  m_funcEvaluator{ *this } {}
 
 void SemanticAnalyzer::visit(AstModule& ast) {
     m_astRootModule = &ast;
     m_fileId = ast.fileId;
-    ast.symbolTable = m_context.create<SymbolTable>(nullptr);
-    m_rootTable = m_table = ast.symbolTable;
+    ast.symbolTable = m_context.create<SymbolTable>();
+    m_rootTable = ast.symbolTable;
 
     Sem::FuncDeclarerPass(m_context, m_typePass).visit(ast);
+    m_funcEvaluator.declare(*ast.stmtList);
 
+    m_scopes.enter(m_rootTable);
     visit(*ast.stmtList);
+    m_scopes.leave();
+
+    Sem::FuncEffectsPass().visit(ast);
 }
 
 void SemanticAnalyzer::visit(AstStmtList& ast) {
@@ -65,11 +72,17 @@ void SemanticAnalyzer::visit(AstVarDecl& ast) {
 
     // expression?
     if (ast.expr) {
+        if (type != nullptr && type->isDynamicArray()) {
+            fatalError("Dynamic array "_t + ast.name + " cannot have an initializer");
+        }
         expression(ast.expr, type);
     }
 
     if (type == nullptr) {
         type = ast.expr->type;
+        if (type->isDynamicArray()) {
+            fatalError("Dynamic array cannot be copied to "_t + ast.name);
+        }
     }
 
     // The Symbol
@@ -81,7 +94,8 @@ void SemanticAnalyzer::visit(AstVarDecl& ast) {
     ast.symbol = symbol;
     auto flags = ast.symbol->getFlags();
     flags.addressable = true;
-    flags.assignable = true;
+    // dynamic array owns its buffer, it is only changed by REDIM and APPEND
+    flags.assignable = !type->isDynamicArray();
     if (type->isPointer()) {
         flags.dereferencable = true;
     }
@@ -93,6 +107,56 @@ void SemanticAnalyzer::visit(AstVarDecl& ast) {
             symbol->setAlias(*alias);
         }
     }
+    symbol->setAlignment(getAlignment(ast.attributes));
+}
+
+unsigned SemanticAnalyzer::getAlignment(const AstAttributeList* attribs) {
+    static constexpr uint64_t maxAlignment = 4096;
+    if (attribs == nullptr) {
+        return 0;
+    }
+    auto alignment = attribs->getIntegerLiteral("ALIGN");
+    if (!alignment) {
+        return 0;
+    }
+    if (!llvm::isPowerOf2_64(*alignment) || *alignment > maxAlignment) {
+        fatalError("Alignment must be a power of 2 up to "_t + llvm::Twine(maxAlignment) + ", got " + llvm::Twine(*alignment));
+    }
+    return static_cast<unsigned>(*alignment);
+}
+
+void SemanticAnalyzer::visit(AstConstDecl& ast) {
+    const TypeRoot* type = nullptr;
+    if (ast.typeExpr) {
+        visit(*ast.typeExpr);
+        type = ast.typeExpr->type;
+    }
+
+    expression(ast.expr, type);
+
+    // Constant arrays are stored in read only memory, so neither they
+    // nor their elements are addressable or assignable
+    if (type != nullptr && type->isArray()) {
+        const auto* init = dyn_cast<AstArrayExpr>(ast.expr);
+        if (init == nullptr || !init->isConstant()) {
+            fatalError("Constant "_t + ast.name + " is not initialized with a constant expression");
+        }
+        auto* symbol = createNewSymbol(ast);
+        symbol->setType(type);
+        ast.symbol = symbol;
+        return;
+    }
+
+    auto* literal = dyn_cast<AstLiteralExpr>(ast.expr);
+    if (literal == nullptr) {
+        fatalError("Constant "_t + ast.name + " is not initialized with a constant expression");
+    }
+
+    // Constants have no storage: not addressable nor assignable
+    auto* symbol = createNewSymbol(ast);
+    symbol->setType(literal->type);
+    symbol->setConstantValue(literal);
+    ast.symbol = symbol;
 }
 
 //----------------------------------------
@@ -111,11 +175,38 @@ void SemanticAnalyzer::visit(AstFuncParamDecl& /*ast*/) {
 }
 
 void SemanticAnalyzer::visit(AstFuncStmt& ast) {
-    RESTORE_ON_EXIT(m_table);
+    // body may have been analyzed already for compile time evaluation
+    if (!m_analyzedFuncs.try_emplace(&ast, false).second) {
+        return;
+    }
+
+    // function sees only the module scope, even when analyzed
+    // on demand from a nested scope
+    auto suspended = m_scopes.suspend(1);
     RESTORE_ON_EXIT(m_function);
     m_function = ast.decl;
-    m_table = ast.decl->symbolTable;
+    m_scopes.enter(ast.decl->symbolTable);
     visit(*ast.stmtList);
+    m_scopes.leave();
+    m_scopes.resume(std::move(suspended));
+    m_analyzedFuncs[&ast] = true;
+}
+
+/**
+ * Function bodies are analyzed in declaration order. Analyze body
+ * ahead of time so that it can be evaluated. Fails for recursive
+ * calls and inside loops, where body would see the enclosing
+ * control flow stack.
+ */
+bool SemanticAnalyzer::ensureAnalyzed(AstFuncStmt& ast) {
+    if (auto iter = m_analyzedFuncs.find(&ast); iter != m_analyzedFuncs.end()) {
+        return iter->second;
+    }
+    if (m_controlStack.cbegin() != m_controlStack.cend()) {
+        return false;
+    }
+    visit(ast);
+    return true;
 }
 
 void SemanticAnalyzer::visit(AstReturnStmt& ast) {
@@ -152,21 +243,17 @@ void SemanticAnalyzer::visit(AstReturnStmt& ast) {
     }
 }
 
+/**
+ * Variables declared in a block header are visible in all following
+ * blocks, so header scopes stay open until the end of the statement.
+ * Block body gets a nested scope sharing the block table.
+ */
 void SemanticAnalyzer::visit(AstIfStmt& ast) {
-    RESTORE_ON_EXIT(m_table);
     for (auto& block : ast.blocks) {
-        block.symbolTable = m_context.create<SymbolTable>(m_table);
-    }
-
-    for (size_t idx = 0; idx < ast.blocks.size(); idx++) {
-        auto& block = ast.blocks[idx];
-
-        m_table = block.symbolTable;
+        block.symbolTable = m_context.create<SymbolTable>();
+        m_scopes.enter(block.symbolTable);
         for (auto& var : block.decls) {
             visit(*var);
-            for (size_t next = idx + 1; next < ast.blocks.size(); next++) {
-                ast.blocks[next].symbolTable->addReference(var->symbol);
-            }
         }
         if (block.expr) {
             expression(block.expr);
@@ -176,7 +263,13 @@ void SemanticAnalyzer::visit(AstIfStmt& ast) {
                     + "' cannot be used as boolean");
             }
         }
+        m_scopes.nest();
         visit(*block.stmt);
+        m_scopes.leave();
+    }
+
+    for (size_t idx = 0; idx < ast.blocks.size(); idx++) {
+        m_scopes.leave();
     }
 }
 
@@ -185,9 +278,8 @@ void SemanticAnalyzer::visit(AstForStmt& ast) {
 }
 
 void SemanticAnalyzer::visit(AstDoLoopStmt& ast) {
-    RESTORE_ON_EXIT(m_table);
-    ast.symbolTable = m_context.create<SymbolTable>(m_table);
-    m_table = ast.symbolTable;
+    ast.symbolTable = m_context.create<SymbolTable>();
+    m_scopes.enter(ast.symbolTable);
 
     for (auto& var : ast.decls) {
         visit(*var);
@@ -205,6 +297,7 @@ void SemanticAnalyzer::visit(AstDoLoopStmt& ast) {
     m_controlStack.push(ControlFlowStatement::Do);
     visit(*ast.stmt);
     m_controlStack.pop();
+    m_scopes.leave();
 }
 
 void SemanticAnalyzer::visit(AstContinuationStmt& ast) {
@@ -246,7 +339,13 @@ void SemanticAnalyzer::visit(AstTypeExpr& ast) {
 //----------------------------------------
 
 void SemanticAnalyzer::expression(AstExpr*& ast, const TypeRoot* type) {
+    if (auto* array = dyn_cast<AstArrayExpr>(ast)) {
+        return arrayInit(*array, type);
+    }
+    intrinsicCall(ast);
+    arrayIndex(ast);
     visit(*ast);
+    m_funcEvaluator.fold(ast);
     m_constantFolder.fold(ast);
     if (type != nullptr) {
         coerce(ast, type);
@@ -255,7 +354,7 @@ void SemanticAnalyzer::expression(AstExpr*& ast, const TypeRoot* type) {
 }
 
 void SemanticAnalyzer::visit(AstAssignExpr& ast) {
-    visit(*ast.lhs);
+    expression(ast.lhs);
     if (!ast.lhs->flags.assignable) {
         fatalError("Cannot assign");
     }
@@ -263,11 +362,14 @@ void SemanticAnalyzer::visit(AstAssignExpr& ast) {
 }
 
 void SemanticAnalyzer::visit(AstIdentExpr& ast) {
-    auto* symbol = m_table->find(ast.name);
+    auto* symbol = m_scopes.find(ast.name);
     if (symbol == nullptr) {
         fatalError("Unknown identifier "_t + ast.name);
     }
+    identifier(ast, symbol);
+}
 
+void SemanticAnalyzer::identifier(AstIdentExpr& ast, Symbol* symbol) {
     const auto* type = symbol->type();
     if (type == nullptr) {
         fatalError("Identifier "_t + ast.name + " has unresolved type");
@@ -343,13 +445,13 @@ void SemanticAnalyzer::visit(AstUnaryExpr& ast) {
 
     switch (ast.tokenKind) {
     case TokenKind::LogicalNot:
-        if (type->isBoolean()) {
+        if (type->getScalarType()->isBoolean() || type->getScalarType()->isIntegral()) {
             ast.type = type;
             return;
         }
-        fatalError("Applying unary NOT to non bool type");
+        fatalError("Applying unary NOT to non bool or integral type");
     case TokenKind::Negate:
-        if (type->isNumeric()) {
+        if (type->getScalarType()->isNumeric()) {
             ast.type = type;
             return;
         }
@@ -366,7 +468,7 @@ void SemanticAnalyzer::visit(AstUnaryExpr& ast) {
 void SemanticAnalyzer::visit(AstDereference& ast) {
     // TODO dereference needs to return a reference to value, NOT value itself
 
-    visit(*ast.expr);
+    expression(ast.expr);
     if (const auto* type = dyn_cast<TypePointer>(ast.expr->type)) {
         ast.type = type->getBase();
     } else {
@@ -384,7 +486,7 @@ void SemanticAnalyzer::visit(AstDereference& ast) {
 //------------------------------------------------------------------
 
 void SemanticAnalyzer::visit(AstAddressOf& ast) {
-    visit(*ast.expr);
+    expression(ast.expr);
     if (!ast.expr->flags.addressable) {
         fatalError("Cannot take address");
     }
@@ -398,7 +500,7 @@ void SemanticAnalyzer::visit(AstAddressOf& ast) {
 //------------------------------------------------------------------
 
 void SemanticAnalyzer::visit(AstMemberAccess& ast) {
-    visit(*ast.lhs);
+    expression(ast.lhs);
     const auto* type = ast.lhs->type;
 
     const TypeUDT* udt = nullptr;
@@ -414,13 +516,343 @@ void SemanticAnalyzer::visit(AstMemberAccess& ast) {
         fatalError("Accessing member of non UDT type");
     }
 
-    RESTORE_ON_EXIT(m_table);
-    m_table = &udt->getSymbolTable();
-    visit(*ast.rhs);
+    // members are resolved in the UDT's own table
+    auto* member = dyn_cast<AstIdentExpr>(ast.rhs);
+    if (member == nullptr) {
+        fatalError("Expected member name");
+    }
+    auto* symbol = udt->getSymbolTable().find(member->name);
+    if (symbol == nullptr) {
+        fatalError("Unknown identifier "_t + member->name);
+    }
+    identifier(*member, symbol);
     ast.type = ast.rhs->type;
     ast.flags = ast.rhs->flags;
 }
 
+//------------------------------------------------------------------
+// Arrays
+//------------------------------------------------------------------
+
+/**
+ * Parser cannot tell array indexing from a call, both are `a(i)`.
+ * Rewrite calls on arrays and on UDT members into index expressions:
+ *   a(i, j) -> (a(i))(j)
+ *   p.a(i)  -> (p.a)(i)
+ * Pointer index binds tighter than member access, so re-associate it too:
+ *   p.a[i]  -> (p.a)[i]
+ */
+void SemanticAnalyzer::arrayIndex(AstExpr*& ast) {
+    if (auto* member = dyn_cast<AstMemberAccess>(ast)) {
+        if (auto* call = dyn_cast<AstCallExpr>(member->rhs)) {
+            member->rhs = call->callable;
+            visit(*member);
+            if (!member->type->isArray() && !member->type->isDynamicArray()) {
+                const auto& name = static_cast<AstIdentExpr*>(member->rhs)->name;
+                fatalError("Member "_t + name + " of type '" + member->type->asString() + "' is not an array");
+            }
+            ast = makeIndex(member, *call);
+        } else if (auto* index = dyn_cast<AstIndexExpr>(member->rhs)) {
+            auto* innermost = index;
+            while (auto* next = dyn_cast<AstIndexExpr>(innermost->expr)) {
+                innermost = next;
+            }
+            member->rhs = innermost->expr;
+            innermost->expr = member;
+            arrayIndex(innermost->expr);
+            ast = index;
+        }
+        return;
+    }
+
+    if (auto* call = dyn_cast<AstCallExpr>(ast)) {
+        if (auto* ident = dyn_cast<AstIdentExpr>(call->callable)) {
+            visit(*ident);
+            if (ident->type->isArray() || ident->type->isDynamicArray()) {
+                ast = makeIndex(ident, *call);
+            }
+        }
+    }
+}
+
+AstExpr* SemanticAnalyzer::makeIndex(AstExpr* expr, AstCallExpr& call) {
+    if (call.args->exprs.empty()) {
+        fatalError("Missing array index");
+    }
+    for (auto* index : call.args->exprs) {
+        expr = m_context.create<AstIndexExpr>(
+            llvm::SMRange{ expr->range.Start, index->range.End },
+            expr,
+            index);
+    }
+    return expr;
+}
+
+void SemanticAnalyzer::visit(AstIndexExpr& ast) {
+    expression(ast.expr);
+
+    expression(ast.index);
+    if (!ast.index->type->isIntegral()) {
+        fatalError("Array index must be integral, got '"_t + ast.index->type->asString() + "'");
+    }
+
+    if (const auto* array = dyn_cast<TypeArray>(ast.expr->type)) {
+        ast.type = array->getElement();
+        ast.flags = ast.expr->flags;
+    } else if (const auto* dynamic = dyn_cast<TypeDynamicArray>(ast.expr->type)) {
+        // elements live in the heap buffer, writable even through a parameter
+        ast.type = dynamic->getElement();
+        ast.flags.addressable = true;
+        ast.flags.assignable = true;
+    } else if (const auto* pointer = dyn_cast<TypePointer>(ast.expr->type)) {
+        if (pointer->isAnyPointer()) {
+            fatalError("Indexing an ANY PTR");
+        }
+        ast.type = pointer->getBase();
+        ast.flags.addressable = true;
+        ast.flags.assignable = true;
+    } else if (const auto* vector = dyn_cast<TypeVector>(ast.expr->type)) {
+        if (const auto* literal = dyn_cast<AstLiteralExpr>(ast.index)) {
+            auto lane = std::get<uint64_t>(literal->value);
+            if (ast.index->type->isSignedIntegral()) {
+                lane = static_cast<uint64_t>(llvm::SignExtend64(lane, static_cast<const TypeIntegral*>(ast.index->type)->getBits()));
+            }
+            if (lane >= vector->getLanes()) {
+                fatalError("Lane "_t + Twine(static_cast<int64_t>(lane)) + " is out of range for '" + vector->asString() + "'");
+            }
+        }
+        // boolean lanes are bits, they cannot be addressed
+        ast.type = vector->getElement();
+        ast.flags = ast.expr->flags;
+        if (ast.type->isBoolean()) {
+            ast.flags.addressable = false;
+            ast.flags.assignable = false;
+        }
+    } else {
+        fatalError("Indexing a non array type '"_t + ast.expr->type->asString() + "'");
+    }
+    ast.flags.dereferencable = ast.type->isPointer();
+}
+
+void SemanticAnalyzer::visit(AstArrayExpr& /*ast*/) {
+    fatalError("Array initializer can only be used with an array type");
+}
+
+/**
+ * `{ a, b, ... }` initializes the array element by element,
+ * elements without initializer are set to 0
+ */
+void SemanticAnalyzer::arrayInit(AstArrayExpr& ast, const TypeRoot* type) {
+    const auto* array = llvm::dyn_cast_or_null<TypeArray>(type);
+    if (array == nullptr) {
+        fatalError("Array initializer can only be used with an array type");
+    }
+    if (ast.elements.size() > array->getSize()) {
+        fatalError("Too many initializers for "_t + array->asString());
+    }
+    for (auto& element : ast.elements) {
+        expression(element, array->getElement());
+    }
+    ast.type = array;
+}
+
+void SemanticAnalyzer::visit(AstBoundExpr& ast) {
+    expression(ast.expr);
+    if (!ast.expr->type->isArray() && !ast.expr->type->isDynamicArray()) {
+        fatalError("Bound of a non array type '"_t + ast.expr->type->asString() + "'");
+    }
+    ast.type = TypeIntegral::fromTokenKind(TokenKind::Long);
+}
+
+/**
+ * Mask picks lanes from lhs followed by lanes of rhs. Result has
+ * as many lanes as there are mask entries
+ */
+void SemanticAnalyzer::visit(AstShuffleExpr& ast) {
+    expression(ast.lhs);
+    const auto* vector = dyn_cast<TypeVector>(ast.lhs->type);
+    if (vector == nullptr) {
+        fatalError("Shuffle of a non vector type '"_t + ast.lhs->type->asString() + "'");
+    }
+    uint64_t limit = vector->getLanes();
+    if (ast.rhs != nullptr) {
+        expression(ast.rhs, vector);
+        limit *= 2;
+    }
+
+    auto& elements = ast.maskExpr->elements;
+    if (!TypeVector::isValidLanes(elements.size())) {
+        fatalError("Shuffle mask must have power of 2 lanes up to "_t + Twine(TypeVector::MAX_LANES));
+    }
+    ast.mask.clear();
+    ast.mask.reserve(elements.size());
+    for (auto*& element : elements) {
+        expression(element);
+        const auto* literal = dyn_cast<AstLiteralExpr>(element);
+        if (literal == nullptr || !element->type->isIntegral()) {
+            fatalError("Shuffle mask must be integral constants");
+        }
+        auto lane = std::get<uint64_t>(literal->value);
+        if (element->type->isSignedIntegral()) {
+            lane = static_cast<uint64_t>(llvm::SignExtend64(lane, static_cast<const TypeIntegral*>(element->type)->getBits()));
+        }
+        if (lane >= limit) {
+            fatalError("Shuffle lane "_t + Twine(static_cast<int64_t>(lane)) + " is out of range");
+        }
+        ast.mask.push_back(static_cast<int>(lane));
+    }
+    ast.type = TypeVector::get(m_context, vector->getElement(), static_cast<unsigned>(elements.size()));
+}
+
+//------------------------------------------------------------------
+// Intrinsics
+//------------------------------------------------------------------
+
+/**
+ * Calls to built-in functions are rewritten to intrinsics, unless
+ * the name is declared in the program
+ */
+void SemanticAnalyzer::intrinsicCall(AstExpr*& ast) {
+    auto* call = dyn_cast<AstCallExpr>(ast);
+    if (call == nullptr) {
+        return;
+    }
+    auto* ident = dyn_cast<AstIdentExpr>(call->callable);
+    if (ident == nullptr || m_scopes.find(ident->name) != nullptr) {
+        return;
+    }
+    if (auto intrinsic = AstIntrinsicExpr::find(ident->name)) {
+        ast = m_context.create<AstIntrinsicExpr>(call->range, *intrinsic, call->args);
+    }
+}
+
+/**
+ * Overloads are picked by argument type:
+ *   SQR, FLOOR, CEIL, FMA   floating point, integers convert to DOUBLE
+ *   ABS, MIN, MAX           any numeric type
+ *   POPCOUNT, CLZ, CTZ,
+ *   BSWAP                   integral types
+ *   PREFETCH                pointer, returns nothing
+ * Vectors are accepted wherever their element type is.
+ */
+void SemanticAnalyzer::visit(AstIntrinsicExpr& ast) {
+    intrinsicArgs(ast);
+    auto& args = ast.args->exprs;
+    const auto* type = args[0]->type;
+    const auto* scalar = type->getScalarType();
+    auto name = AstIntrinsicExpr::getName(ast.intrinsic);
+
+    switch (ast.intrinsic) {
+    case IntrinsicKind::Sqr:
+    case IntrinsicKind::Floor:
+    case IntrinsicKind::Ceil:
+    case IntrinsicKind::Fma:
+        if (scalar->isIntegral()) {
+            const auto* dbl = TypeRoot::fromTokenKind(TokenKind::Double);
+            if (const auto* vector = dyn_cast<TypeVector>(type)) {
+                dbl = TypeVector::get(m_context, dbl, vector->getLanes());
+            }
+            for (auto*& arg : args) {
+                convert(arg, dbl);
+            }
+            type = dbl;
+        } else if (!scalar->isFloatingPoint()) {
+            fatalError(""_t + name + " expects a numeric argument, got '" + type->asString() + "'");
+        }
+        break;
+    case IntrinsicKind::Abs:
+    case IntrinsicKind::Min:
+    case IntrinsicKind::Max:
+        if (!scalar->isNumeric()) {
+            fatalError(""_t + name + " expects a numeric argument, got '" + type->asString() + "'");
+        }
+        break;
+    case IntrinsicKind::PopCount:
+    case IntrinsicKind::Clz:
+    case IntrinsicKind::Ctz:
+    case IntrinsicKind::BSwap:
+        if (!scalar->isIntegral()) {
+            fatalError(""_t + name + " expects an integral argument, got '" + type->asString() + "'");
+        }
+        break;
+    case IntrinsicKind::Prefetch:
+        if (!type->isPointer()) {
+            fatalError(""_t + name + " expects a pointer, got '" + type->asString() + "'");
+        }
+        type = TypeVoid::get();
+        break;
+    }
+    ast.type = type;
+}
+
+/**
+ * Analyze arguments and convert them all to the widest one
+ */
+void SemanticAnalyzer::intrinsicArgs(AstIntrinsicExpr& ast) {
+    auto& args = ast.args->exprs;
+    if (args.size() != AstIntrinsicExpr::getArgCount(ast.intrinsic)) {
+        fatalError("Argument count mismatch for "_t + AstIntrinsicExpr::getName(ast.intrinsic));
+    }
+
+    const TypeRoot* common = nullptr;
+    for (auto*& arg : args) {
+        expression(arg);
+        if (common == nullptr) {
+            common = arg->type;
+            continue;
+        }
+        switch (common->compare(arg->type)) {
+        case TypeComparison::Incompatible:
+            fatalError("Incompatible arguments '"_t + common->asString() + "' and '" + arg->type->asString() + "'");
+        case TypeComparison::Downcast:
+        case TypeComparison::Equal:
+            break;
+        case TypeComparison::Upcast:
+            common = arg->type;
+            break;
+        }
+    }
+    for (auto*& arg : args) {
+        if (arg->type != common) {
+            convert(arg, common);
+        }
+    }
+}
+
+//------------------------------------------------------------------
+// Dynamic arrays
+//------------------------------------------------------------------
+
+void SemanticAnalyzer::visit(AstRedimStmt& ast) {
+    resizableArray(ast.expr);
+
+    expression(ast.upper);
+    if (!ast.upper->type->isIntegral()) {
+        fatalError("Array bound must be integral, got '"_t + ast.upper->type->asString() + "'");
+    }
+}
+
+void SemanticAnalyzer::visit(AstAppendStmt& ast) {
+    const auto* array = resizableArray(ast.expr);
+    expression(ast.value, array->getElement());
+}
+
+/**
+ * Parameters receive a copy of the array value, resizing it would
+ * leave the caller with a released buffer
+ */
+const TypeDynamicArray* SemanticAnalyzer::resizableArray(AstExpr*& ast) {
+    expression(ast);
+    const auto* array = dyn_cast<TypeDynamicArray>(ast->type);
+    if (array == nullptr) {
+        fatalError("Expected a dynamic array, got '"_t + ast->type->asString() + "'");
+    }
+    if (!ast->flags.addressable) {
+        fatalError("Dynamic array parameter cannot be resized");
+    }
+    return array;
+}
+
 //------------------------------------------------------------------
 // Binary Expressions
 //------------------------------------------------------------------
@@ -429,6 +861,10 @@ void SemanticAnalyzer::visit(AstBinaryExpr& ast) {
     expression(ast.lhs);
     expression(ast.rhs);
 
+    if (ast.lhs->type->isVector() || ast.rhs->type->isVector()) {
+        return vectorBinary(ast);
+    }
+
     switch (Token::getOperatorType(ast.tokenKind)) {
     case OperatorType::Arithmetic:
         return arithmetic(ast);
@@ -436,6 +872,8 @@ void SemanticAnalyzer::visit(AstBinaryExpr& ast) {
         return comparison(ast);
     case OperatorType::Logical:
         return logical(ast);
+    case OperatorType::Bitwise:
+        return shift(ast);
     default:
         llvm_unreachable("invalid operator");
     }
@@ -445,6 +883,10 @@ void SemanticAnalyzer::arithmetic(AstBinaryExpr& ast) {
     const auto* left = ast.lhs->type;
     const auto* right = ast.rhs->type;
 
+    if (left->isPointer() || right->isPointer()) {
+        return pointerArithmetic(ast);
+    }
+
     if (!left->isNumeric() || !right->isNumeric()) {
         fatalError("Applying artithmetic operation to non numeric type");
     }
@@ -468,12 +910,143 @@ void SemanticAnalyzer::arithmetic(AstBinaryExpr& ast) {
     }
 }
 
+/**
+ * Offsets count elements, not bytes:
+ *   p + n, n + p, p - n -> pointer
+ *   p - q               -> LONG distance in elements
+ */
+void SemanticAnalyzer::pointerArithmetic(AstBinaryExpr& ast) {
+    const auto* left = ast.lhs->type;
+    const auto* right = ast.rhs->type;
+
+    if (left->isAnyPointer() || right->isAnyPointer()) {
+        fatalError("Pointer arithmetic on ANY PTR");
+    }
+
+    if (left->isPointer() && right->isPointer()) {
+        if (ast.tokenKind != TokenKind::Minus) {
+            fatalError("Only subtraction is allowed between pointers");
+        }
+        if (left != right) {
+            fatalError("Subtracting incompatible pointer types '"_t + left->asString() + "' and '" + right->asString() + "'");
+        }
+        ast.type = TypeIntegral::fromTokenKind(TokenKind::Long);
+        return;
+    }
+
+    const auto* offset = left->isPointer() ? right : left;
+    if (!offset->isIntegral()) {
+        fatalError("Pointer offset must be integral, got '"_t + offset->asString() + "'");
+    }
+    if (ast.tokenKind == TokenKind::Plus || (ast.tokenKind == TokenKind::Minus && left->isPointer())) {
+        ast.type = left->isPointer() ? left : right;
+        return;
+    }
+    fatalError("Invalid pointer arithmetic");
+}
+
+/**
+ * Operators apply to every lane. Logical operators on BOOLEAN vectors
+ * evaluate both operands
+ */
+void SemanticAnalyzer::vectorBinary(AstBinaryExpr& ast) {
+    const auto* left = ast.lhs->type;
+    const auto* right = ast.rhs->type;
+
+    switch (left->compare(right)) {
+    case TypeComparison::Incompatible:
+        fatalError("Operator on incompatible types '"_t + left->asString() + "' and '" + right->asString() + "'");
+    case TypeComparison::Downcast:
+        convert(ast.rhs, left);
+        break;
+    case TypeComparison::Equal:
+        break;
+    case TypeComparison::Upcast:
+        convert(ast.lhs, right);
+        break;
+    }
+
+    const auto* vector = llvm::cast<TypeVector>(ast.lhs->type);
+    const auto* element = vector->getElement();
+    switch (Token::getOperatorType(ast.tokenKind)) {
+    case OperatorType::Arithmetic:
+        if (!element->isNumeric()) {
+            fatalError("Applying artithmetic operation to non numeric type");
+        }
+        ast.type = vector;
+        return;
+    case OperatorType::Comparison:
+        if (!canPerformBinary(ast.tokenKind, element, element)) {
+            fatalError("Cannot apply operationg to types");
+        }
+        ast.type = TypeVector::get(m_context, TypeBoolean::get(), vector->getLanes());
+        return;
+    case OperatorType::Logical:
+        if (!element->isBoolean() && !element->isIntegral()) {
+            fatalError("Applying logical operator to non boolean or integral type");
+        }
+        ast.type = vector;
+        return;
+    case OperatorType::Bitwise:
+        if (!element->isIntegral()) {
+            fatalError("Shifting non integral type");
+        }
+        ast.type = vector;
+        return;
+    default:
+        llvm_unreachable("invalid operator");
+    }
+}
+
+/**
+ * AND, OR and XOR are logical on BOOLEAN and bitwise on integral
+ * operands. Only logical AND and OR short circuit
+ */
 void SemanticAnalyzer::logical(AstBinaryExpr& ast) {
     const auto* left = ast.lhs->type;
     const auto* right = ast.rhs->type;
 
-    if (!left->isBoolean() || !right->isBoolean()) {
-        fatalError("Applying logical operator to non boolean type");
+    if (left->isBoolean() && right->isBoolean()) {
+        ast.type = left;
+        return;
+    }
+    if (!left->isIntegral() || !right->isIntegral()) {
+        fatalError("Applying logical operator to non boolean or integral type");
+    }
+
+    const auto unify = [&](AstExpr*& expr, const TypeRoot* ty) {
+        cast(expr, ty);
+        m_constantFolder.fold(expr);
+        ast.type = ty;
+    };
+
+    switch (left->compare(right)) {
+    case TypeComparison::Incompatible:
+        fatalError("Operator on incompatible types");
+    case TypeComparison::Downcast:
+        return unify(ast.rhs, left);
+    case TypeComparison::Equal:
+        ast.type = left;
+        return;
+    case TypeComparison::Upcast:
+        return unify(ast.lhs, right);
+    }
+}
+
+/**
+ * Result has the type of shifted value. SHR is arithmetic
+ * for signed types
+ */
+void SemanticAnalyzer::shift(AstBinaryExpr& ast) {
+    const auto* left = ast.lhs->type;
+    const auto* right = ast.rhs->type;
+
+    if (!left->isIntegral() || !right->isIntegral()) {
+        fatalError("Shifting non integral type");
+    }
+    if (left != right) {
+        cast(ast.rhs, left);
+        m_constantFolder.fold(ast.rhs);
     }
     ast.type = left;
 }
@@ -529,6 +1102,9 @@ void SemanticAnalyzer::visit(AstCastExpr& ast) {
     if (ast.expr->type->compare(ast.type) == TypeComparison::Incompatible) {
         fatalError("Incompatible cast");
     }
+    if (ast.expr->type->isVector() && !ast.type->isVector()) {
+        fatalError("Cannot cast '"_t + ast.expr->type->asString() + "' to scalar '" + ast.type->asString() + "'");
+    }
 
     ast.flags = ast.expr->flags;
 }
@@ -545,7 +1121,12 @@ void SemanticAnalyzer::coerce(AstExpr*& ast, const TypeRoot* type) {
     const auto* src = type;
     const auto* dst = ast->type;
 
-    switch (src->compare(dst)) {
+    auto comparison = src->compare(dst);
+    if (dst->isVector() && !src->isVector()) {
+        comparison = TypeComparison::Incompatible;
+    }
+
+    switch (comparison) {
     case TypeComparison::Incompatible:
         fatalError(
             "Type mismatch."_t
@@ -575,8 +1156,17 @@ void SemanticAnalyzer::cast(AstExpr*& ast, const TypeRoot* type) {
 // IfExpr
 //------------------------------------------------------------------
 
+/**
+ * BOOLEAN vector condition selects every lane from either operand
+ */
 void SemanticAnalyzer::visit(AstIfExpr& ast) {
-    expression(ast.expr, TypeBoolean::get());
+    expression(ast.expr);
+    const auto* mask = dyn_cast<TypeVector>(ast.expr->type);
+    if (mask == nullptr || !mask->getElement()->isBoolean()) {
+        mask = nullptr;
+        coerce(ast.expr, TypeBoolean::get());
+        m_constantFolder.fold(ast.expr);
+    }
     expression(ast.trueExpr);
     expression(ast.falseExpr);
 
@@ -592,12 +1182,28 @@ void SemanticAnalyzer::visit(AstIfExpr& ast) {
     case TypeComparison::Incompatible:
         fatalError("Incompatible types");
     case TypeComparison::Downcast:
-        return convert(ast.falseExpr, left);
+        convert(ast.falseExpr, left);
+        break;
     case TypeComparison::Equal:
         ast.type = left;
-        return;
+        break;
     case TypeComparison::Upcast:
-        return convert(ast.trueExpr, right);
+        convert(ast.trueExpr, right);
+        break;
+    }
+
+    // scalar operands are splat across the lanes
+    if (mask != nullptr && !ast.type->isVector()) {
+        const auto* vector = TypeVector::get(m_context, ast.type, mask->getLanes());
+        convert(ast.trueExpr, vector);
+        convert(ast.falseExpr, vector);
+        ast.type = vector;
+    }
+    if (mask != nullptr) {
+        const auto* vector = dyn_cast<TypeVector>(ast.type);
+        if (vector == nullptr || vector->getLanes() != mask->getLanes()) {
+            fatalError("Selecting '"_t + ast.type->asString() + "' with '" + mask->asString() + "'");
+        }
     }
 }
 
@@ -606,10 +1212,10 @@ void SemanticAnalyzer::visit(AstIfExpr& ast) {
 //------------------------------------------------------------------
 
 Symbol* SemanticAnalyzer::createNewSymbol(AstDecl& ast) {
-    if (m_table->find(ast.name, false) != nullptr) {
+    auto* symbol = m_scopes.insert(m_context, ast.name);
+    if (symbol == nullptr) {
         fatalError("Redefinition of "_t + ast.name);
     }
-    auto* symbol = m_table->insert(m_context, ast.name);
 
     // alias?
     if (ast.attributes != nullptr) {
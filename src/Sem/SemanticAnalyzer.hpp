@@ -6,13 +6,16 @@
 #include "Ast/ControlFlowStack.hpp"
 #include "Ast/ValueFlags.hpp"
 #include "Passes/ConstantFoldingPass.hpp"
+#include "Passes/FuncEvaluatorPass.hpp"
 #include "Passes/TypePass.hpp"
+#include "Symbol/ScopedSymbolTable.hpp"
 
 namespace lbc {
 class Token;
 class Symbol;
 class SymbolTable;
 class TypeRoot;
+class TypeDynamicArray;
 class Context;
 
 class SemanticAnalyzer final : public AstVisitor<SemanticAnalyzer> {
@@ -35,15 +38,31 @@ public:
 
     [[nodiscard]] Symbol* createNewSymbol(AstDecl& ast);
 
-    [[nodiscard]] SymbolTable* getSymbolTable() { return m_table; }
-    void setSymbolTable(SymbolTable* table) { m_table = table; }
+    /// Alignment from [Align(n)] attribute, 0 if not given
+    [[nodiscard]] static unsigned getAlignment(const AstAttributeList* attribs);
+
+    [[nodiscard]] ScopedSymbolTable& getScopes() noexcept { return m_scopes; }
+    [[nodiscard]] SymbolTable* getRootSymbolTable() noexcept { return m_rootTable; }
 
     [[nodiscard]] auto& getControlStack() { return m_controlStack; }
 
+    /// Analyze function body ahead of its declaration, if possible
+    [[nodiscard]] bool ensureAnalyzed(AstFuncStmt& ast);
+
     AST_VISITOR_DECLARE_CONTENT_FUNCS()
 private:
+    void identifier(AstIdentExpr& ast, Symbol* symbol);
+    void arrayIndex(AstExpr*& ast);
+    void intrinsicCall(AstExpr*& ast);
+    void intrinsicArgs(AstIntrinsicExpr& ast);
+    [[nodiscard]] AstExpr* makeIndex(AstExpr* expr, AstCallExpr& call);
+    void arrayInit(AstArrayExpr& ast, const TypeRoot* type);
+    const TypeDynamicArray* resizableArray(AstExpr*& ast);
     void arithmetic(AstBinaryExpr& ast);
+    void pointerArithmetic(AstBinaryExpr& ast);
+    void vectorBinary(AstBinaryExpr& ast);
     void logical(AstBinaryExpr& ast);
+    void shift(AstBinaryExpr& ast);
     void comparison(AstBinaryExpr& ast);
     [[nodiscard]] bool canPerformBinary(TokenKind op, const TypeRoot* left, const TypeRoot* right) const noexcept;
 
@@ -51,10 +70,12 @@ private:
     unsigned int m_fileId = ~0U;
     AstModule* m_astRootModule = nullptr;
     AstFuncDecl* m_function = nullptr;
-    SymbolTable* m_table = nullptr;
     SymbolTable* m_rootTable = nullptr;
+    ScopedSymbolTable m_scopes;
     Sem::ConstantFoldingPass m_constantFolder;
     Sem::TypePass m_typePass;
+    Sem::FuncEvaluatorPass m_funcEvaluator;
+    llvm::DenseMap<AstFuncStmt*, bool> m_analyzedFuncs;
 
     ControlFlowStack<> m_controlStack;
 };
@@ -0,0 +1,78 @@
+//
+// Created by agent on 18/10/2026.
+//
+#include "ScopedSymbolTable.hpp"
+#include "Symbol.hpp"
+#include "SymbolTable.hpp"
+using namespace lbc;
+
+void ScopedSymbolTable::enter(SymbolTable* table) {
+    m_scopes.emplace_back(table, m_declared.size());
+    for (auto& entry : *table) {
+        bind(entry.second);
+    }
+}
+
+void ScopedSymbolTable::nest() {
+    m_scopes.emplace_back(getTable(), m_declared.size());
+}
+
+void ScopedSymbolTable::leave() {
+    auto start = m_scopes.back().second;
+    while (m_declared.size() > start) {
+        m_bindings.find(m_declared.back()->name())->second.pop_back();
+        m_declared.pop_back();
+    }
+    m_scopes.pop_back();
+}
+
+Symbol* ScopedSymbolTable::insert(Context& context, StringRef name) {
+    auto* table = getTable();
+    if (table->exists(name)) {
+        return nullptr;
+    }
+    auto* symbol = table->insert(context, name);
+    bind(symbol);
+    return symbol;
+}
+
+void ScopedSymbolTable::bind(Symbol* symbol) {
+    m_bindings[symbol->name()].push_back(symbol);
+    m_declared.push_back(symbol);
+}
+
+Symbol* ScopedSymbolTable::find(StringRef name) const noexcept {
+    auto iter = m_bindings.find(name);
+    if (iter == m_bindings.end() || iter->second.empty()) {
+        return nullptr;
+    }
+    return iter->second.back();
+}
+
+ScopedSymbolTable::Suspended ScopedSymbolTable::suspend(size_t depth) {
+    Suspended suspended;
+    if (depth >= m_scopes.size()) {
+        return suspended;
+    }
+
+    auto start = m_scopes[depth].second;
+    suspended.scopes.assign(m_scopes.begin() + static_cast<std::ptrdiff_t>(depth), m_scopes.end());
+    suspended.symbols.assign(m_declared.begin() + static_cast<std::ptrdiff_t>(start), m_declared.end());
+    while (m_scopes.size() > depth) {
+        leave();
+    }
+    return suspended;
+}
+
+void ScopedSymbolTable::resume(Suspended suspended) {
+    size_t index = 0;
+    for (size_t scope = 0; scope < suspended.scopes.size(); scope++) {
+        m_scopes.push_back(suspended.scopes[scope]);
+        auto end = scope + 1 < suspended.scopes.size()
+            ? suspended.scopes[scope + 1].second
+            : m_declared.size() + suspended.symbols.size() - index;
+        while (m_declared.size() < end) {
+            bind(suspended.symbols[index++]);
+        }
+    }
+}
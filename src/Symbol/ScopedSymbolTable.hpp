@@ -0,0 +1,69 @@
+//
+// Created by agent on 18/10/2026.
+//
+#pragma once
+
+namespace lbc {
+class Context;
+class Symbol;
+class SymbolTable;
+
+/**
+ * Resolves identifiers in nested scopes during semantic analysis.
+ *
+ * Every identifier maps to a stack of visible symbols, innermost on top.
+ * Entering a scope pushes nothing, declaring a symbol pushes it onto
+ * its name's stack and leaving a scope pops the symbols declared in it.
+ * Lookups cost a single hash probe regardless of nesting depth.
+ *
+ * Symbols are still stored in the SymbolTable of the scope they are
+ * declared in.
+ */
+class ScopedSymbolTable final {
+public:
+    NO_COPY_AND_MOVE(ScopedSymbolTable)
+    ScopedSymbolTable() noexcept = default;
+    ~ScopedSymbolTable() noexcept = default;
+
+    /// Scopes hidden by suspend, to be restored by resume
+    struct Suspended final {
+        std::vector<std::pair<SymbolTable*, size_t>> scopes;
+        std::vector<Symbol*> symbols;
+    };
+
+    /// Open a scope storing declarations in the table.
+    /// Symbols already in the table become visible
+    void enter(SymbolTable* table);
+
+    /// Open a scope storing declarations in current table. Symbols
+    /// already in the table stay bound by the enclosing scope
+    void nest();
+
+    /// Close current scope, hiding symbols declared in it
+    void leave();
+
+    /// Declare symbol in current scope. Returns nullptr if name is
+    /// already declared in the table of current scope
+    [[nodiscard]] Symbol* insert(Context& context, StringRef name);
+
+    /// Make symbol visible in current scope
+    void bind(Symbol* symbol);
+
+    [[nodiscard]] Symbol* find(StringRef name) const noexcept;
+
+    [[nodiscard]] SymbolTable* getTable() const noexcept { return m_scopes.back().first; }
+    [[nodiscard]] size_t depth() const noexcept { return m_scopes.size(); }
+
+    /// Hide scopes nested deeper than given depth, e.g. to analyze
+    /// function body out of order
+    [[nodiscard]] Suspended suspend(size_t depth);
+    void resume(Suspended suspended);
+
+private:
+    llvm::StringMap<llvm::SmallVector<Symbol*, 1>> m_bindings;
+    std::vector<Symbol*> m_declared;
+    // scope table and size of m_declared when scope was entered
+    std::vector<std::pair<SymbolTable*, size_t>> m_scopes;
+};
+
+} // namespace lbc
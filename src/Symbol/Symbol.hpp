@@ -6,6 +6,19 @@
 
 namespace lbc {
 class TypeRoot;
+struct AstLiteralExpr;
+
+/**
+ * Side effects of a function, inferred by Sem::FuncEffectsPass.
+ * Defaults assume the worst, as for external functions
+ */
+struct FuncEffects final {
+    bool readsMemory = true;
+    bool writesMemory = true;
+    // memory is only accessed through pointer parameters
+    bool argMemOnly = false;
+    bool willReturn = false;
+};
 
 class Symbol final {
 public:
@@ -25,6 +38,10 @@ public:
     [[nodiscard]] unsigned int getIndex() const noexcept { return m_index; }
     void setIndex(unsigned int index) noexcept { m_index = index; }
 
+    /// Alignment requested with [Align(n)], 0 for natural alignment
+    [[nodiscard]] unsigned int getAlignment() const noexcept { return m_alignment; }
+    void setAlignment(unsigned int alignment) noexcept { m_alignment = alignment; }
+
     [[nodiscard]] const TypeRoot* type() const noexcept { return m_type; }
     void setType(const TypeRoot* type) noexcept { m_type = type; }
 
@@ -36,6 +53,13 @@ public:
     [[nodiscard]] llvm::Value* getLlvmValue() const noexcept { return m_llvmValue; }
     void setLlvmValue(llvm::Value* value) noexcept { m_llvmValue = value; }
 
+    /// Value of a CONST symbol, substituted at every use
+    [[nodiscard]] AstLiteralExpr* getConstantValue() const noexcept { return m_constantValue; }
+    void setConstantValue(AstLiteralExpr* value) noexcept { m_constantValue = value; }
+
+    [[nodiscard]] const FuncEffects& getFuncEffects() const noexcept { return m_funcEffects; }
+    void setFuncEffects(const FuncEffects& effects) noexcept { m_funcEffects = effects; }
+
     [[nodiscard]] StringRef alias() const noexcept { return m_alias; }
     void setAlias(StringRef alias) noexcept { m_alias = alias; }
 
@@ -69,10 +93,13 @@ private:
 
     StringRef m_alias;
     llvm::Value* m_llvmValue = nullptr;
+    AstLiteralExpr* m_constantValue = nullptr;
     bool m_external = false;
     Symbol* m_parent = nullptr;
     unsigned int m_index = 0;
+    unsigned int m_alignment = 0;
     ValueFlags m_flags{};
+    FuncEffects m_funcEffects{};
 };
 
 } // namespace lbc
@@ -12,35 +12,14 @@ Symbol* SymbolTable::insert(Context& context, StringRef name) {
     return m_symbols.insert({ name, symbol }).first->second;
 }
 
-void SymbolTable::addReference(Symbol* symbol) {
-    m_references.insert({ symbol->name(), symbol });
+bool SymbolTable::exists(StringRef name) const noexcept {
+    return m_symbols.find(name) != m_symbols.end();
 }
 
-bool SymbolTable::exists(StringRef name, bool recursive) const noexcept {
-    if (m_symbols.find(name) != m_symbols.end()) {
-        return true;
-    }
-
-    if (m_references.find(name) != m_references.end()) {
-        return true;
-    }
-
-    return recursive && m_parent != nullptr && m_parent->exists(name, recursive);
-}
-
-Symbol* SymbolTable::find(StringRef id, bool recursive) const noexcept {
+Symbol* SymbolTable::find(StringRef id) const noexcept {
     if (auto iter = m_symbols.find(id); iter != m_symbols.end()) {
         return iter->second;
     }
-
-    if (auto iter = m_references.find(id); iter != m_references.end()) {
-        return iter->second;
-    }
-
-    if (recursive && m_parent != nullptr) {
-        return m_parent->find(id, true);
-    }
-
     return nullptr;
 }
 
@@ -12,17 +12,13 @@ class SymbolTable final {
 
 public:
     NO_COPY_AND_MOVE(SymbolTable)
-    explicit SymbolTable(SymbolTable* parent = nullptr) noexcept : m_parent{ parent } {}
+    SymbolTable() noexcept = default;
     ~SymbolTable() noexcept = default;
 
-    [[nodiscard]] SymbolTable* getParent() const noexcept { return m_parent; }
-    void setParent(SymbolTable* parent) noexcept { m_parent = parent; }
-
     Symbol* insert(Context& context, StringRef name);
-    void addReference(Symbol*);
 
-    [[nodiscard]] bool exists(StringRef name, bool recursive = false) const noexcept;
-    [[nodiscard]] Symbol* find(StringRef id, bool recursive = true) const noexcept;
+    [[nodiscard]] bool exists(StringRef name) const noexcept;
+    [[nodiscard]] Symbol* find(StringRef id) const noexcept;
     [[nodiscard]] std::vector<Symbol*> getSymbols() const;
 
     [[nodiscard]] auto size() const noexcept { return m_symbols.size(); }
@@ -44,9 +40,7 @@ public:
     }
 
 private:
-    SymbolTable* m_parent;
     Container m_symbols;
-    llvm::StringMap<Symbol*> m_references;
 };
 
 } // namespace lbc
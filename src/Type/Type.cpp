@@ -32,6 +32,17 @@ const TypePointer anyPtrTy{ &anyTy }; // void*
     FLOATINGPOINT_TYPES(DEFINE_TYPE)
 #undef DEFINE_TYPE
 
+/**
+ * Allocate a uniqued type. Caller must hold Context::typesMutex.
+ * Destructors are not run, so T must not own any memory
+ */
+template<typename T, typename... Args>
+T* createType(Context& context, Args&&... args) {
+    auto* type = static_cast<T*>(context.typeAllocator.Allocate(sizeof(T), alignof(T)));
+    new (type) T(std::forward<Args>(args)...);
+    return type;
+}
+
 } // namespace
 
 const TypeRoot* TypeRoot::fromTokenKind(TokenKind kind) noexcept {
@@ -55,6 +66,20 @@ const TypeRoot* TypeRoot::fromTokenKind(TokenKind kind) noexcept {
 
 // clang-format on
 
+llvm::Type* TypeRoot::getLlvmType(Context& context) const noexcept {
+    if (auto iter = context.llvmTypes.find(this); iter != context.llvmTypes.end()) {
+        return iter->second;
+    }
+    // generating may recurse into other types and grow the cache
+    auto* type = genLlvmType(context);
+    context.llvmTypes[this] = type;
+    return type;
+}
+
+uint64_t TypeRoot::getAlignment(Context& context) const {
+    return context.getDataLayout().getABITypeAlign(getLlvmType(context)).value();
+}
+
 bool TypeRoot::isAnyPointer() const noexcept {
     return this == &anyPtrTy;
 }
@@ -73,6 +98,13 @@ bool TypeRoot::isUnsignedIntegral() const noexcept {
     return !static_cast<const TypeIntegral*>(this)->isSigned();
 }
 
+const TypeRoot* TypeRoot::getScalarType() const noexcept {
+    if (const auto* vector = dyn_cast<TypeVector>(this)) {
+        return vector->getElement();
+    }
+    return this;
+}
+
 // clang-format off
 #define CHECK_TYPE_IMPL(ID, ...)             \
     bool TypeRoot::is##ID() const noexcept { \
@@ -88,6 +120,27 @@ TypeComparison TypeRoot::compare(const TypeRoot* other) const noexcept {
         return TypeComparison::Equal;
     }
 
+    // lanes convert element wise, scalars are converted to the element
+    // type and copied into every lane
+    if (const auto* left = dyn_cast<TypeVector>(this)) {
+        if (const auto* right = dyn_cast<TypeVector>(other)) {
+            if (left->getLanes() != right->getLanes()) {
+                return TypeComparison::Incompatible;
+            }
+            return left->getElement()->compare(right->getElement());
+        }
+        if (left->getElement()->compare(other) == TypeComparison::Incompatible) {
+            return TypeComparison::Incompatible;
+        }
+        return TypeComparison::Downcast;
+    }
+    if (const auto* right = dyn_cast<TypeVector>(other)) {
+        if (compare(right->getElement()) == TypeComparison::Incompatible) {
+            return TypeComparison::Incompatible;
+        }
+        return TypeComparison::Upcast;
+    }
+
     if (const auto* left = dyn_cast<TypePointer>(this)) {
         if (const auto* right = dyn_cast<TypePointer>(other)) {
             if (left->getBase()->isAny()) {
@@ -169,14 +222,11 @@ const TypePointer* TypePointer::get(Context& context, const TypeRoot* base) noex
         return &anyPtrTy;
     }
 
-    for (const auto& ptr : context.ptrTypes) {
-        if (ptr->m_base == base) {
-            return ptr;
-        }
+    std::lock_guard<std::mutex> lock{ context.typesMutex };
+    auto& ty = context.ptrTypes[base];
+    if (ty == nullptr) {
+        ty = createType<TypePointer>(context, base);
     }
-
-    auto* ty = context.create<TypePointer>(base);
-    context.ptrTypes.push_back(ty);
     return ty;
 }
 
@@ -278,17 +328,36 @@ const TypeFunction* TypeFunction::get(
     const TypeRoot* retType,
     std::vector<const TypeRoot*> paramTypes,
     bool variadic) noexcept {
-    for (const auto& ptr : context.funcTypes) {
-        if (ptr->getReturn() == retType && ptr->getParams() == paramTypes && ptr->isVariadic() == variadic) {
-            return ptr;
-        }
+    llvm::FoldingSetNodeID id;
+    Profile(id, retType, paramTypes, variadic);
+
+    std::lock_guard<std::mutex> lock{ context.typesMutex };
+    void* insertPos = nullptr;
+    if (auto* ty = context.funcTypes.FindNodeOrInsertPos(id, insertPos)) {
+        return ty;
     }
 
-    auto ty = context.create<TypeFunction>(retType, std::move(paramTypes), variadic);
-    context.funcTypes.push_back(ty);
+    auto* ty = new (context.funcTypeAllocator.Allocate()) TypeFunction(retType, std::move(paramTypes), variadic);
+    context.funcTypes.InsertNode(ty, insertPos);
     return ty;
 }
 
+void TypeFunction::Profile(llvm::FoldingSetNodeID& id) const {
+    Profile(id, m_retType, m_paramTypes, m_variadic);
+}
+
+void TypeFunction::Profile(
+    llvm::FoldingSetNodeID& id,
+    const TypeRoot* retType,
+    const std::vector<const TypeRoot*>& paramTypes,
+    bool variadic) {
+    id.AddPointer(retType);
+    id.AddBoolean(variadic);
+    for (const auto* param : paramTypes) {
+        id.AddPointer(param);
+    }
+}
+
 llvm::Type* TypeFunction::genLlvmType(Context& context) const {
     auto* retTy = m_retType->getLlvmType(context);
 
@@ -328,3 +397,98 @@ llvm::Type* TypeZString::genLlvmType(Context& context) const {
 string TypeZString::asString() const {
     return "ZSTRING";
 }
+
+// Array
+
+const TypeArray* TypeArray::get(Context& context, const TypeRoot* element, int64_t lower, uint64_t size) noexcept {
+    llvm::FoldingSetNodeID id;
+    Profile(id, element, lower, size);
+
+    std::lock_guard<std::mutex> lock{ context.typesMutex };
+    void* insertPos = nullptr;
+    if (auto* ty = context.arrayTypes.FindNodeOrInsertPos(id, insertPos)) {
+        return ty;
+    }
+
+    auto* ty = createType<TypeArray>(context, element, lower, size);
+    context.arrayTypes.InsertNode(ty, insertPos);
+    return ty;
+}
+
+void TypeArray::Profile(llvm::FoldingSetNodeID& id) const {
+    Profile(id, m_element, m_lower, m_size);
+}
+
+void TypeArray::Profile(llvm::FoldingSetNodeID& id, const TypeRoot* element, int64_t lower, uint64_t size) {
+    id.AddPointer(element);
+    id.AddInteger(lower);
+    id.AddInteger(size);
+}
+
+llvm::Type* TypeArray::genLlvmType(Context& context) const {
+    return llvm::ArrayType::get(m_element->getLlvmType(context), m_size);
+}
+
+uint64_t TypeArray::getAlignment(Context& context) const {
+    return m_element->getAlignment(context);
+}
+
+string TypeArray::asString() const {
+    // INTEGER(0 TO 2, 1 TO 3)
+    string dims;
+    const TypeRoot* type = this;
+    while (const auto* array = dyn_cast<TypeArray>(type)) {
+        if (!dims.empty()) {
+            dims += ", ";
+        }
+        dims += std::to_string(array->getLowerBound()) + " TO " + std::to_string(array->getUpperBound());
+        type = array->getElement();
+    }
+    return type->asString() + "(" + dims + ")";
+}
+
+// Dynamic array
+
+const TypeDynamicArray* TypeDynamicArray::get(Context& context, const TypeRoot* element) noexcept {
+    std::lock_guard<std::mutex> lock{ context.typesMutex };
+    auto& ty = context.dynArrayTypes[element];
+    if (ty == nullptr) {
+        ty = createType<TypeDynamicArray>(context, element);
+    }
+    return ty;
+}
+
+llvm::Type* TypeDynamicArray::genLlvmType(Context& context) const {
+    auto& llvmContext = context.getLlvmContext();
+    auto* sizeTy = llvm::Type::getInt64Ty(llvmContext);
+    return llvm::StructType::get(
+        llvmContext,
+        { llvm::PointerType::get(m_element->getLlvmType(context), 0), sizeTy, sizeTy });
+}
+
+string TypeDynamicArray::asString() const {
+    return m_element->asString() + "()";
+}
+
+// Vector
+
+const TypeVector* TypeVector::get(Context& context, const TypeRoot* element, unsigned lanes) noexcept {
+    std::lock_guard<std::mutex> lock{ context.typesMutex };
+    auto& ty = context.vectorTypes[{ element, lanes }];
+    if (ty == nullptr) {
+        ty = createType<TypeVector>(context, element, lanes);
+    }
+    return ty;
+}
+
+bool TypeVector::isValidLanes(uint64_t lanes) noexcept {
+    return lanes > 1 && lanes <= MAX_LANES && llvm::isPowerOf2_64(lanes);
+}
+
+llvm::Type* TypeVector::genLlvmType(Context& context) const {
+    return llvm::FixedVectorType::get(m_element->getLlvmType(context), m_lanes);
+}
+
+string TypeVector::asString() const {
+    return m_element->asString() + " VECTOR(" + std::to_string(m_lanes) + ")";
+}
@@ -3,6 +3,7 @@
 //
 #pragma once
 #include "Type.def.hpp"
+#include <llvm/ADT/FoldingSet.h>
 
 namespace lbc {
 
@@ -17,6 +18,9 @@ enum class TypeFamily {
 
     Function, // function
     ZString,  // nil terminated string, byte ptr / char*
+    Array,    // fixed size array of another type
+    DynamicArray, // growable heap allocated array
+    Vector,       // fixed number of lanes operated on element wise
 
     UDT, // User defined Type (C struct)
 };
@@ -28,6 +32,9 @@ class TypeIntegral;
 class TypeFloatingPoint;
 class TypeFunction;
 class TypeZString;
+class TypeArray;
+class TypeDynamicArray;
+class TypeVector;
 class Context;
 enum class TokenKind;
 
@@ -49,12 +56,9 @@ public:
 
     [[nodiscard]] constexpr TypeFamily getKind() const noexcept { return m_kind; }
 
-    [[nodiscard]] llvm::Type* getLlvmType(Context& context) const noexcept {
-        if (m_llvmType == nullptr) {
-            m_llvmType = genLlvmType(context);
-        }
-        return m_llvmType;
-    }
+    [[nodiscard]] llvm::Type* getLlvmType(Context& context) const noexcept;
+    /// ABI alignment in bytes
+    [[nodiscard]] virtual uint64_t getAlignment(Context& context) const;
     virtual ~TypeRoot() noexcept = default;
     [[nodiscard]] static const TypeRoot* fromTokenKind(TokenKind kind) noexcept;
     [[nodiscard]] virtual string asString() const = 0;
@@ -70,10 +74,16 @@ public:
     [[nodiscard]] constexpr bool isFunction() const noexcept { return m_kind == TypeFamily::Function; }
     [[nodiscard]] constexpr bool isZString() const noexcept { return m_kind == TypeFamily::ZString; }
     [[nodiscard]] constexpr bool isUDT() const noexcept { return m_kind == TypeFamily::UDT; }
+    [[nodiscard]] constexpr bool isArray() const noexcept { return m_kind == TypeFamily::Array; }
+    [[nodiscard]] constexpr bool isDynamicArray() const noexcept { return m_kind == TypeFamily::DynamicArray; }
+    [[nodiscard]] constexpr bool isVector() const noexcept { return m_kind == TypeFamily::Vector; }
     [[nodiscard]] bool isAnyPointer() const noexcept;
     [[nodiscard]] bool isSignedIntegral() const noexcept;
     [[nodiscard]] bool isUnsignedIntegral() const noexcept;
 
+    /// Element type of a vector, the type itself otherwise
+    [[nodiscard]] const TypeRoot* getScalarType() const noexcept;
+
     [[nodiscard]] TypeComparison compare(const TypeRoot* other) const noexcept;
 
     // clang-format off
@@ -91,7 +101,6 @@ protected:
     [[nodiscard]] virtual llvm::Type* genLlvmType(Context& context) const = 0;
 
 private:
-    mutable llvm::Type* m_llvmType = nullptr;
     const TypeFamily m_kind;
 };
 
@@ -248,7 +257,7 @@ protected:
 /**
  * Function typeExpr
  */
-class TypeFunction final : public TypeRoot {
+class TypeFunction final : public TypeRoot, public llvm::FoldingSetNode {
 public:
     TypeFunction(const TypeRoot* retType, std::vector<const TypeRoot*>&& paramTypes, bool variadic) noexcept
     : TypeRoot{ TypeFamily::Function },
@@ -272,6 +281,14 @@ public:
     [[nodiscard]] const std::vector<const TypeRoot*>& getParams() const noexcept { return m_paramTypes; }
     [[nodiscard]] bool isVariadic() const noexcept { return m_variadic; }
 
+    /// Used by llvm::FoldingSet for uniquing
+    void Profile(llvm::FoldingSetNodeID& id) const; // NOLINT
+    static void Profile( // NOLINT
+        llvm::FoldingSetNodeID& id,
+        const TypeRoot* retType,
+        const std::vector<const TypeRoot*>& paramTypes,
+        bool variadic);
+
 protected:
     [[nodiscard]] llvm::Type* genLlvmType(Context& context) const final;
 
@@ -302,4 +319,112 @@ protected:
     [[nodiscard]] llvm::Type* genLlvmType(Context& context) const final;
 };
 
+/**
+ * Fixed size array with elements laid out contiguously.
+ * Multi dimensional arrays are arrays of arrays
+ */
+class TypeArray final : public TypeRoot, public llvm::FoldingSetNode {
+public:
+    TypeArray(const TypeRoot* element, int64_t lower, uint64_t size) noexcept
+    : TypeRoot{ TypeFamily::Array },
+      m_element{ element },
+      m_lower{ lower },
+      m_size{ size } {}
+
+    [[nodiscard]] static const TypeArray* get(
+        Context& context,
+        const TypeRoot* element,
+        int64_t lower,
+        uint64_t size) noexcept;
+
+    constexpr static bool classof(const TypeRoot* type) noexcept {
+        return type->getKind() == TypeFamily::Array;
+    }
+
+    [[nodiscard]] string asString() const final;
+
+    [[nodiscard]] const TypeRoot* getElement() const noexcept { return m_element; }
+    [[nodiscard]] int64_t getLowerBound() const noexcept { return m_lower; }
+    [[nodiscard]] int64_t getUpperBound() const noexcept { return m_lower + static_cast<int64_t>(m_size) - 1; }
+    [[nodiscard]] uint64_t getSize() const noexcept { return m_size; }
+    [[nodiscard]] uint64_t getAlignment(Context& context) const final;
+
+    /// Used by llvm::FoldingSet for uniquing
+    void Profile(llvm::FoldingSetNodeID& id) const; // NOLINT
+    static void Profile( // NOLINT
+        llvm::FoldingSetNodeID& id,
+        const TypeRoot* element,
+        int64_t lower,
+        uint64_t size);
+
+protected:
+    [[nodiscard]] llvm::Type* genLlvmType(Context& context) const final;
+
+private:
+    const TypeRoot* m_element;
+    const int64_t m_lower;
+    const uint64_t m_size;
+};
+
+/**
+ * Zero based array that can be resized at runtime.
+ * Represented as { data, length, capacity } value, elements are stored
+ * contiguously in a heap buffer managed by the runtime library
+ */
+class TypeDynamicArray final : public TypeRoot {
+public:
+    constexpr explicit TypeDynamicArray(const TypeRoot* element) noexcept
+    : TypeRoot{ TypeFamily::DynamicArray }, m_element{ element } {}
+
+    [[nodiscard]] static const TypeDynamicArray* get(Context& context, const TypeRoot* element) noexcept;
+
+    constexpr static bool classof(const TypeRoot* type) noexcept {
+        return type->getKind() == TypeFamily::DynamicArray;
+    }
+
+    [[nodiscard]] string asString() const final;
+
+    [[nodiscard]] constexpr const TypeRoot* getElement() const noexcept { return m_element; }
+
+protected:
+    [[nodiscard]] llvm::Type* genLlvmType(Context& context) const final;
+
+private:
+    const TypeRoot* m_element;
+};
+
+/**
+ * SIMD vector of numeric or boolean elements. Arithmetic, comparisons
+ * and conversions apply to every lane, scalars used with vectors are
+ * copied into all lanes. Comparisons produce a BOOLEAN vector
+ */
+class TypeVector final : public TypeRoot {
+public:
+    static constexpr unsigned MAX_LANES = 64;
+
+    constexpr TypeVector(const TypeRoot* element, unsigned lanes) noexcept
+    : TypeRoot{ TypeFamily::Vector }, m_element{ element }, m_lanes{ lanes } {}
+
+    [[nodiscard]] static const TypeVector* get(Context& context, const TypeRoot* element, unsigned lanes) noexcept;
+
+    constexpr static bool classof(const TypeRoot* type) noexcept {
+        return type->getKind() == TypeFamily::Vector;
+    }
+
+    /// Lane count must be a power of 2 up to MAX_LANES
+    [[nodiscard]] static bool isValidLanes(uint64_t lanes) noexcept;
+
+    [[nodiscard]] string asString() const final;
+
+    [[nodiscard]] constexpr const TypeRoot* getElement() const noexcept { return m_element; }
+    [[nodiscard]] constexpr unsigned getLanes() const noexcept { return m_lanes; }
+
+protected:
+    [[nodiscard]] llvm::Type* genLlvmType(Context& context) const final;
+
+private:
+    const TypeRoot* m_element;
+    const unsigned m_lanes;
+};
+
 } // namespace lbc
@@ -7,15 +7,17 @@
 #include "Symbol/SymbolTable.hpp"
 using namespace lbc;
 
-TypeUDT::TypeUDT(Symbol& symbol, SymbolTable& symbolTable, bool packed)
+TypeUDT::TypeUDT(Context& context, Symbol& symbol, SymbolTable& symbolTable, bool packed, uint64_t alignment, bool reorder)
 : TypeRoot{ TypeFamily::UDT },
   m_symbol{ symbol },
   m_symbolTable{ symbolTable },
-  m_packed(packed) {
+  m_packed(packed),
+  m_alignment{ std::max<uint64_t>(alignment, 1) } {
     symbol.setType(this);
+    layout(context, reorder);
 }
 
-const TypeUDT* TypeUDT::get(Context& context, Symbol& symbol, SymbolTable& symbolTable, bool packed) {
+const TypeUDT* TypeUDT::get(Context& context, Symbol& symbol, SymbolTable& symbolTable, bool packed, uint64_t alignment, bool reorder) {
     if (const auto* type = symbol.type()) {
         if (const auto* udt = dyn_cast<TypeUDT>(type)) {
             return udt;
@@ -23,7 +25,78 @@ const TypeUDT* TypeUDT::get(Context& context, Symbol& symbol, SymbolTable& symbo
         fatalError("Symbol should hold UDT type pointer!");
     }
 
-    return context.create<TypeUDT>(symbol, symbolTable, packed);
+    return context.create<TypeUDT>(context, symbol, symbolTable, packed, alignment, reorder);
+}
+
+/**
+ * Place members in declaration order, or by decreasing alignment
+ * when reordering. llvm already pads to the ABI alignment of every
+ * element (except in packed structs), padding is added only where
+ * [Align(n)] asks for more.
+ */
+void TypeUDT::layout(Context& context, bool reorder) {
+    const auto& dataLayout = context.getDataLayout();
+
+    struct Member final {
+        Symbol* symbol;
+        llvm::Type* llvmType;
+        uint64_t alignment;
+        uint64_t abiAlignment;
+    };
+    std::vector<Member> members;
+    members.reserve(m_symbolTable.size());
+    for (auto* symbol : m_symbolTable.getSymbols()) {
+        auto* llvmType = symbol->type()->getLlvmType(context);
+        uint64_t abiAlignment = 1;
+        uint64_t alignment = symbol->getAlignment();
+        if (!m_packed) {
+            abiAlignment = dataLayout.getABITypeAlign(llvmType).value();
+            alignment = std::max(alignment, symbol->type()->getAlignment(context));
+        }
+        members.push_back({ symbol, llvmType, std::max(alignment, abiAlignment), abiAlignment });
+    }
+
+    // sizes are multiples of alignment, so no gaps are left between
+    // members sorted from the most to the least aligned
+    if (reorder) {
+        std::stable_sort(members.begin(), members.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.alignment > rhs.alignment;
+        });
+    }
+
+    m_fields.reserve(members.size());
+    m_elementIndexes.resize(members.size());
+
+    uint64_t offset = 0;
+    uint64_t implicitAlignment = 1;
+    uint64_t used = 0;
+    unsigned element = 0;
+    for (const auto& member : members) {
+        auto aligned = llvm::alignTo(offset, member.alignment);
+        uint64_t padding = 0;
+        if (aligned > llvm::alignTo(offset, member.abiAlignment)) {
+            padding = aligned - offset;
+            element++;
+        }
+        m_fields.push_back({ member.symbol, padding });
+        m_elementIndexes[member.symbol->getIndex()] = element++;
+
+        auto size = dataLayout.getTypeAllocSize(member.llvmType).getFixedSize();
+        offset = aligned + size;
+        used += size;
+        implicitAlignment = std::max(implicitAlignment, member.abiAlignment);
+        m_alignment = std::max(m_alignment, member.alignment);
+    }
+
+    m_size = llvm::alignTo(offset, m_alignment);
+    m_padding = m_size - used;
+    if (m_size > llvm::alignTo(offset, implicitAlignment)) {
+        m_tailPadding = m_size - offset;
+    }
+}
+
+unsigned TypeUDT::getElementIndex(const Symbol& member) const noexcept {
+    return m_elementIndexes[member.getIndex()];
 }
 
 string TypeUDT::asString() const {
@@ -31,11 +104,17 @@ string TypeUDT::asString() const {
 }
 
 llvm::Type* TypeUDT::genLlvmType(Context& context) const {
+    auto* byteTy = llvm::Type::getInt8Ty(context.getLlvmContext());
     llvm::SmallVector<llvm::Type*> elems;
-    elems.reserve(m_symbolTable.size());
-    for (auto* symbol : m_symbolTable.getSymbols()) {
-        auto* ty = symbol->type()->getLlvmType(context);
-        elems.emplace_back(ty);
+    elems.reserve(m_fields.size() + 1);
+    for (const auto& field : m_fields) {
+        if (field.padding > 0) {
+            elems.emplace_back(llvm::ArrayType::get(byteTy, field.padding));
+        }
+        elems.emplace_back(field.member->type()->getLlvmType(context));
+    }
+    if (m_tailPadding > 0) {
+        elems.emplace_back(llvm::ArrayType::get(byteTy, m_tailPadding));
     }
     return llvm::StructType::create(
         context.getLlvmContext(),
@@ -11,13 +11,25 @@ class Context;
 
 /**
  * User defined type
+ *
+ * Member offsets are laid out when the type is created. Members
+ * aligned beyond their natural alignment are preceded by explicit
+ * i8 padding in the llvm struct and reordered members are placed
+ * by alignment, so member symbol index may differ from its llvm
+ * element index.
  */
 class TypeUDT final : public TypeRoot {
-    TypeUDT(Symbol& symbol, SymbolTable& symbolTable, bool packed);
+    TypeUDT(Context& context, Symbol& symbol, SymbolTable& symbolTable, bool packed, uint64_t alignment, bool reorder);
     friend class Context;
 
 public:
-    static const TypeUDT* get(Context& context, Symbol& symbol, SymbolTable& symbolTable, bool packed);
+    static const TypeUDT* get(
+        Context& context,
+        Symbol& symbol,
+        SymbolTable& symbolTable,
+        bool packed,
+        uint64_t alignment = 0,
+        bool reorder = false);
 
     constexpr static bool classof(const TypeRoot* type) {
         return type->getKind() == TypeFamily::UDT;
@@ -27,14 +39,34 @@ public:
 
     [[nodiscard]] Symbol& getSymbol() const noexcept { return m_symbol; }
     [[nodiscard]] SymbolTable& getSymbolTable() const noexcept { return m_symbolTable; }
+    [[nodiscard]] uint64_t getAlignment(Context& /* context */) const final { return m_alignment; }
+
+    /// Index of the member in generated llvm struct
+    [[nodiscard]] unsigned getElementIndex(const Symbol& member) const noexcept;
+
+    /// Bytes not used by any member
+    [[nodiscard]] uint64_t getPadding() const noexcept { return m_padding; }
 
 protected:
     llvm::Type* genLlvmType(Context& context) const final;
 
 private:
+    void layout(Context& context, bool reorder);
+
+    struct Field final {
+        Symbol* member;
+        uint64_t padding; // explicit bytes before the member
+    };
+
     Symbol& m_symbol;
     SymbolTable& m_symbolTable;
     bool m_packed;
+    uint64_t m_alignment;
+    std::vector<Field> m_fields;
+    std::vector<unsigned> m_elementIndexes;
+    uint64_t m_tailPadding = 0;
+    uint64_t m_size = 0;
+    uint64_t m_padding = 0;
 };
 
 } // namespace lbc
@@ -0,0 +1,122 @@
+//
+// Created by agent on 19/10/2026.
+//
+#if defined(__CLION_IDE__)
+#    pragma ide diagnostic ignored "cppcoreguidelines-avoid-non-const-global-variables"
+#    pragma ide diagnostic ignored "cppcoreguidelines-owning-memory"
+#    pragma ide diagnostic ignored "cppcoreguidelines-non-private-member-variables-in-classes"
+#    pragma ide diagnostic ignored "cert-err58-cpp"
+#    pragma ide diagnostic ignored "cppcoreguidelines-special-member-functions"
+#endif
+
+#include "Driver/CompileOptions.hpp"
+#include "Driver/Context.hpp"
+#include "Symbol/ScopedSymbolTable.hpp"
+#include "Symbol/Symbol.hpp"
+#include "Symbol/SymbolTable.hpp"
+#include <gtest/gtest.h>
+namespace {
+
+class ScopedSymbolTableTests : public testing::Test {
+protected:
+    lbc::SymbolTable* table() {
+        return m_context.create<lbc::SymbolTable>();
+    }
+
+    lbc::Symbol* insert(llvm::StringRef name) {
+        return m_scopes.insert(m_context, name);
+    }
+
+    lbc::CompileOptions m_options{};
+    lbc::Context m_context{ m_options };
+    lbc::ScopedSymbolTable m_scopes{};
+};
+
+TEST_F(ScopedSymbolTableTests, FindsDeclaredSymbols) {
+    m_scopes.enter(table());
+    auto* x = insert("X");
+    ASSERT_NE(x, nullptr);
+    EXPECT_EQ(m_scopes.find("X"), x);
+    EXPECT_EQ(m_scopes.find("Y"), nullptr);
+
+    m_scopes.leave();
+    EXPECT_EQ(m_scopes.find("X"), nullptr);
+}
+
+TEST_F(ScopedSymbolTableTests, RejectsRedeclaration) {
+    m_scopes.enter(table());
+    ASSERT_NE(insert("X"), nullptr);
+    EXPECT_EQ(insert("X"), nullptr);
+    m_scopes.leave();
+}
+
+TEST_F(ScopedSymbolTableTests, InnerScopeShadowsOuter) {
+    m_scopes.enter(table());
+    auto* outer = insert("X");
+
+    m_scopes.enter(table());
+    auto* inner = insert("X");
+    ASSERT_NE(inner, nullptr);
+    EXPECT_NE(inner, outer);
+    EXPECT_EQ(m_scopes.find("X"), inner);
+
+    m_scopes.leave();
+    EXPECT_EQ(m_scopes.find("X"), outer);
+    m_scopes.leave();
+}
+
+TEST_F(ScopedSymbolTableTests, EnterBindsExistingSymbols) {
+    auto* scope = table();
+    m_scopes.enter(scope);
+    auto* x = insert("X");
+    m_scopes.leave();
+    EXPECT_EQ(m_scopes.find("X"), nullptr);
+
+    m_scopes.enter(scope);
+    EXPECT_EQ(m_scopes.find("X"), x);
+    m_scopes.leave();
+    EXPECT_EQ(m_scopes.find("X"), nullptr);
+}
+
+TEST_F(ScopedSymbolTableTests, NestedScopeSharesTable) {
+    auto* header = table();
+    m_scopes.enter(header);
+    auto* x = insert("X");
+
+    m_scopes.nest();
+    EXPECT_EQ(m_scopes.getTable(), header);
+    EXPECT_EQ(insert("X"), nullptr);
+    auto* y = insert("Y");
+    EXPECT_TRUE(header->exists("Y"));
+    EXPECT_EQ(m_scopes.find("Y"), y);
+
+    m_scopes.leave();
+    EXPECT_EQ(m_scopes.find("X"), x);
+    EXPECT_EQ(m_scopes.find("Y"), nullptr);
+
+    m_scopes.leave();
+    EXPECT_EQ(m_scopes.find("X"), nullptr);
+}
+
+TEST_F(ScopedSymbolTableTests, SuspendHidesInnerScopes) {
+    m_scopes.enter(table());
+    auto* global = insert("G");
+    m_scopes.enter(table());
+    auto* local = insert("L");
+    auto* shadow = insert("G");
+
+    auto suspended = m_scopes.suspend(1);
+    EXPECT_EQ(m_scopes.depth(), 1U);
+    EXPECT_EQ(m_scopes.find("L"), nullptr);
+    EXPECT_EQ(m_scopes.find("G"), global);
+
+    m_scopes.resume(std::move(suspended));
+    EXPECT_EQ(m_scopes.depth(), 2U);
+    EXPECT_EQ(m_scopes.find("L"), local);
+    EXPECT_EQ(m_scopes.find("G"), shadow);
+
+    m_scopes.leave();
+    m_scopes.leave();
+}
+
+} // namespace